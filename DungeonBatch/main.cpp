@@ -0,0 +1,155 @@
+#include "Dungeon.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment( lib, "psapi.lib" )
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::size_t PeakMemoryKiB( )
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+
+        GetProcessMemoryInfo( GetCurrentProcess( ), &counters, sizeof( counters ) );
+
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        rusage usage;
+
+        getrusage( RUSAGE_SELF, &usage );
+
+        return usage.ru_maxrss;
+#endif
+    }
+
+    DungeonConfiguration ParseConfiguration( const std::string& line )
+    {
+        /* Same comma separated layout as the first line of a save file */
+        std::vector<std::string> data;
+        std::stringstream sstream( line );
+        std::string value;
+
+        while( std::getline( sstream, value, ',' ) )
+        {
+            data.push_back( value );
+        }
+
+        return DungeonConfiguration( data );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    /*
+        Builds dungeons for seeds [first, first + count) without the game loop and prints
+        timing and memory statistics as a single JSON object. Threads build whole dungeons side
+        by side, tile threads split the bands of each dungeon, so a count of one with several
+        tile threads measures how a single dungeon scales.
+        Usage: DungeonBatch <first seed> <count> [threads] [configuration] [tile threads]
+    */
+    static const std::array<const char*, Stage::Count> names
+    {
+        "doors",
+        "wallsOuter",
+        "hiddenPath",
+        "wallsParents",
+        "wallsChildren",
+        "wallsFiller",
+        "connectivity",
+        "rooms",
+        "enemies"
+    };
+
+    if( argc < 3 )
+    {
+        std::cerr << "Usage: DungeonBatch <first seed> <count> [threads] [configuration] [tile threads]\n";
+
+        return 1;
+    }
+
+    const std::uint64_t first = std::stoull( argv[1] );
+    const int count = std::stoi( argv[2] );
+    const int threads = argc > 3 ? std::max( 1, std::stoi( argv[3] ) ) : std::max( 1, static_cast<int>( std::thread::hardware_concurrency( ) ) );
+    DungeonConfiguration config = argc > 4 ? ParseConfiguration( argv[4] ) : DungeonConfiguration( );
+    const int tileThreads = argc > 5 ? std::max( 1, std::stoi( argv[5] ) ) : 1;
+    const EntityFactory entityFactory;
+    PlayerHandle player( entityFactory.PlayerDefault( ) );
+    std::vector<std::array<double, Stage::Count>> timings( count );
+    std::vector<int> cells( count );
+
+    config.options.threads = tileThreads;
+
+    const auto start = std::chrono::steady_clock::now( );
+
+    ParallelFor( count, threads, [&] ( int i )
+    {
+        const Dungeon dungeon( player, entityFactory, config, first + i );
+
+        timings[i] = dungeon.GetTimings( );
+        cells[i] = dungeon.GetSize( ).x * dungeon.GetSize( ).y;
+    } );
+
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start ).count( );
+    std::int64_t cellsTotal = 0;
+
+    for( int value : cells )
+    {
+        cellsTotal += value;
+    }
+
+    std::cout << "{\n";
+    std::cout << "  \"dungeons\": " << count << ",\n";
+    std::cout << "  \"threads\": " << threads << ",\n";
+    std::cout << "  \"tileThreads\": " << tileThreads << ",\n";
+    std::cout << "  \"cells\": " << cellsTotal << ",\n";
+    std::cout << "  \"seconds\": " << seconds << ",\n";
+    std::cout << "  \"dungeonsPerSecond\": " << ( seconds > 0.0 ? count / seconds : 0.0 ) << ",\n";
+    std::cout << "  \"peakMemoryKiB\": " << PeakMemoryKiB( ) << ",\n";
+    std::cout << "  \"stages\": {\n";
+
+    for( int stage = 0; stage < Stage::Count; stage++ )
+    {
+        std::vector<double> samples( count );
+
+        for( int i = 0; i < count; i++ )
+        {
+            samples[i] = timings[i][stage] * 1000.0;
+        }
+
+        std::sort( samples.begin( ), samples.end( ) );
+
+        double total = 0.0;
+
+        for( double sample : samples )
+        {
+            total += sample;
+        }
+
+        std::cout << "    \"" << names[stage] << "\": { ";
+        std::cout << "\"totalMs\": " << total << ", ";
+        std::cout << "\"meanMs\": " << ( count ? total / count : 0.0 ) << ", ";
+        std::cout << "\"medianMs\": " << ( count ? samples[count / 2] : 0.0 ) << ", ";
+        std::cout << "\"maxMs\": " << ( count ? samples.back( ) : 0.0 ) << " }";
+        std::cout << ( stage + 1 < Stage::Count ? ",\n" : "\n" );
+    }
+
+    std::cout << "  }\n";
+    std::cout << "}\n";
+
+    return 0;
+}
\ No newline at end of file
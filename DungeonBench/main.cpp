@@ -0,0 +1,155 @@
+#include "Game.h"
+#include "InputSource.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment( lib, "psapi.lib" )
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::size_t PeakMemoryKiB( )
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+
+        GetProcessMemoryInfo( GetCurrentProcess( ), &counters, sizeof( counters ) );
+
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        rusage usage;
+
+        getrusage( RUSAGE_SELF, &usage );
+
+        return usage.ru_maxrss;
+#endif
+    }
+
+    int BenchmarkCasts( int count, int rounds )
+    {
+        /* Door and Character tests over mixed entities, through dynamic_cast and through EntityCast */
+        static const std::array<const char*, 5> templates { "Door", "Zombie", "Skeleton", "Lunatic", "Wall" };
+        const EntityFactory entityFactory;
+        Arena arena;
+        std::vector<Entity*> entities;
+
+        for( int i = 0; i < count; i++ )
+        {
+            entities.push_back( entityFactory.Get( templates[( i * 7 ) % templates.size( )] )->Clone( arena ) );
+        }
+
+        auto Measure = [&entities, rounds] ( auto test )
+        {
+            std::int64_t matches = 0;
+            const auto start = std::chrono::steady_clock::now( );
+
+            for( int round = 0; round < rounds; round++ )
+            {
+                for( Entity* entity : entities )
+                {
+                    matches += test( entity );
+                }
+            }
+
+            const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start ).count( );
+
+            return std::make_pair( seconds, matches );
+        };
+        const auto dynamic = Measure( [] ( Entity* entity ) { return ( dynamic_cast<Door*>( entity ) != nullptr ) + ( dynamic_cast<Character*>( entity ) != nullptr ); } );
+        const auto tagged = Measure( [] ( Entity* entity ) { return ( EntityCast<Door>( entity ) != nullptr ) + ( EntityCast<Character>( entity ) != nullptr ); } );
+        const double tests = 2.0 * count * rounds;
+
+        std::cout << "{\n";
+        std::cout << "  \"entities\": " << count << ",\n";
+        std::cout << "  \"tests\": " << static_cast<std::int64_t>( tests ) << ",\n";
+        std::cout << "  \"dynamicCastNs\": " << ( tests > 0.0 ? dynamic.first * 1e9 / tests : 0.0 ) << ",\n";
+        std::cout << "  \"entityCastNs\": " << ( tests > 0.0 ? tagged.first * 1e9 / tests : 0.0 ) << ",\n";
+        std::cout << "  \"matchesAgree\": " << ( dynamic.second == tagged.second ? "true" : "false" ) << "\n";
+        std::cout << "}\n";
+
+        return dynamic.second == tagged.second ? 0 : 1;
+    }
+
+    int BenchmarkWalk( int commands, std::uint64_t seed )
+    {
+        /*
+            Plays a headless game from a random walk, starting a random game and then sending
+            moves and battle choices. The menu digits restart the walk when the player dies.
+        */
+        static const std::string keys = "WASDWASD0123";
+        RandomGenerator rng( seed );
+        int sent = 0;
+        GeneratedInput input( [&rng, &sent, commands] ( )
+        {
+            if( sent == commands )
+            {
+                throw InputExhausted( );
+            }
+
+            return std::string( 1, sent++ == 0 ? '3' : keys[rng.Get( 0, keys.size( ) - 1 )] );
+        } );
+        Game game( input, "Dungeoncrawler_Save.txt", seed, true, false, false, false, true );
+        const auto start = std::chrono::steady_clock::now( );
+
+        try
+        {
+            game.Menu( );
+        }
+        catch( const InputExhausted& )
+        { }
+
+        const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start ).count( );
+        const RenderStatistics& statistics = game.GetRenderStatistics( );
+
+        std::cout << "{\n";
+        std::cout << "  \"commands\": " << sent << ",\n";
+        std::cout << "  \"seconds\": " << seconds << ",\n";
+        std::cout << "  \"commandsPerSecond\": " << ( seconds > 0.0 ? sent / seconds : 0.0 ) << ",\n";
+        std::cout << "  \"frames\": " << statistics.frames << ",\n";
+        std::cout << "  \"bytesSent\": " << statistics.bytesSent << ",\n";
+        std::cout << "  \"bytesFull\": " << statistics.bytesFull << ",\n";
+        std::cout << "  \"bytesPerFrame\": " << ( statistics.frames ? static_cast<double>( statistics.bytesSent ) / statistics.frames : 0.0 ) << ",\n";
+        std::cout << "  \"peakMemoryKiB\": " << PeakMemoryKiB( ) << "\n";
+        std::cout << "}\n";
+
+        return 0;
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    /*
+        Microbenchmarks of the game itself, separate from DungeonBatch which only measures
+        dungeon generation. Each mode prints its results as a single JSON object.
+        casts   - Times Door and Character tests through dynamic_cast and EntityCast.
+        walk    - Plays a headless game from a seeded random walk, reporting commands per
+                  second and the bytes the renderer would have written.
+        Usage: DungeonBench casts [entities] [rounds]
+        Usage: DungeonBench walk [commands] [seed]
+    */
+    const std::string mode = argc > 1 ? argv[1] : "";
+
+    if( mode == "casts" )
+    {
+        return BenchmarkCasts( argc > 2 ? std::stoi( argv[2] ) : 4096, argc > 3 ? std::stoi( argv[3] ) : 20000 );
+    }
+
+    if( mode == "walk" )
+    {
+        return BenchmarkWalk( argc > 2 ? std::stoi( argv[2] ) : 100000, argc > 3 ? std::stoull( argv[3] ) : 1 );
+    }
+
+    std::cerr << "Usage: DungeonBench casts [entities] [rounds]\n";
+    std::cerr << "       DungeonBench walk [commands] [seed]\n";
+
+    return 1;
+}
\ No newline at end of file
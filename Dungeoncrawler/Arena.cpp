@@ -0,0 +1,58 @@
+#include "Arena.h"
+#include <algorithm>
+
+Arena::Arena( std::size_t blockSize ) :
+    _blockSize( blockSize ),
+    _current( nullptr ),
+    _remaining( 0 )
+{ }
+Arena::Arena( Arena&& arena ) :
+    _blockSize( arena._blockSize ),
+    _blocks( std::move( arena._blocks ) ),
+    _destructors( std::move( arena._destructors ) ),
+    _current( arena._current ),
+    _remaining( arena._remaining )
+{
+    arena._blocks.clear( );
+    arena._destructors.clear( );
+    arena._current = nullptr;
+    arena._remaining = 0;
+}
+Arena::~Arena( )
+{
+    Release( );
+}
+
+void Arena::Release( )
+{
+    /* Objects are destroyed in reverse order of creation, memory is returned block by block */
+    std::for_each( _destructors.rbegin( ), _destructors.rend( ), [] ( const Destructor& destructor )
+    {
+        destructor.destroy( destructor.object );
+    } );
+
+    _destructors.clear( );
+    _blocks.clear( );
+    _current = nullptr;
+    _remaining = 0;
+}
+void* Arena::Allocate( std::size_t size, std::size_t alignment )
+{
+    void* pointer = _current;
+
+    if( !std::align( alignment, size, pointer, _remaining ) )
+    {
+        const std::size_t sizeBlock = std::max( _blockSize, size + alignment );
+
+        _blocks.emplace_back( new std::byte[sizeBlock] );
+        _current = _blocks.back( ).get( );
+        _remaining = sizeBlock;
+        pointer = _current;
+        std::align( alignment, size, pointer, _remaining );
+    }
+
+    _current = static_cast<std::byte*>( pointer ) + size;
+    _remaining -= size;
+
+    return pointer;
+}
\ No newline at end of file
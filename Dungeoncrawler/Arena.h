@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+class Arena
+{
+    public:
+        Arena( std::size_t blockSize = 1 << 16 );
+        Arena( Arena&& arena );
+        ~Arena( );
+
+        template<class T, class... Args> T* Create( Args&&... args )
+        {
+            T* object = new( Allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( args )... );
+
+            if constexpr( !std::is_trivially_destructible_v<T> )
+            {
+                _destructors.push_back( { object, [] ( void* pointer ) { static_cast<T*>( pointer )->~T( ); } } );
+            }
+
+            return object;
+        }
+        void Release( );
+
+    private:
+        struct Destructor
+        {
+            void* object;
+            void ( *destroy )( void* );
+        };
+
+        std::size_t _blockSize;
+        std::vector<std::unique_ptr<std::byte[]>> _blocks;
+        std::vector<Destructor> _destructors;
+        std::byte* _current;
+        std::size_t _remaining;
+
+        void* Allocate( std::size_t size, std::size_t alignment );
+};
\ No newline at end of file
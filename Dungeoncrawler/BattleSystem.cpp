@@ -9,8 +9,9 @@
 #include <memory>
 #include <functional>
 
-BattleSystem::BattleSystem( bool clear ) :
-    _clearOutput( clear ),
+BattleSystem::BattleSystem( Renderer& renderer, InputSource& input ) :
+    _renderer( renderer ),
+    _input( input ),
     _effects( []( std::vector<Effect> effects )
     {
         std::map<int, Effect> temp;
@@ -40,7 +41,7 @@ void BattleSystem::Encounter( Character& player, Character& AI ) const
     std::string events;
     std::string output;
     bool flee = false;
-    auto ExitCondition = [] ( const std::array<bool, 3> conditions )
+    auto ExitCondition = [this] ( const std::array<bool, 3> conditions )
     {
         static const std::array<std::string, 3> output
         {
@@ -53,9 +54,8 @@ void BattleSystem::Encounter( Character& player, Character& AI ) const
         {
             if( conditions[i] )
             {
-                std::cout << "\nYou " << output[i];
-                std::cout << "Press enter to continue: \n";
-                SelectEnter( );
+                _renderer.Print( "\nYou " + output[i] + "Press enter to continue: \n" );
+                SelectEnter( _input );
 
                 return true;
             }
@@ -66,25 +66,24 @@ void BattleSystem::Encounter( Character& player, Character& AI ) const
 
     while( true )
     {
-        ClearScreen( _clearOutput );
         output.clear( );
         output
             .append( "> BATTLE <\n- " )
-            .append( player.name )
+            .append( player.type.name )
             .append( " vs " )
-            .append( AI.name )
+            .append( AI.type.name )
             .append( "!\n\n> EVENTS <\n" )
             .append( events )
             .append( "\n> HEALTH <\n- " )
-            .append( player.name )
+            .append( player.type.name )
             .append( ": " )
             .append( GetStringHealth( player.health ) )
             .append( "\n- " )
-            .append( AI.name )
+            .append( AI.type.name )
             .append( ": " )
             .append( GetStringHealth( AI.health ) )
             .append( "\n\n> ACTION <\n" );
-        std::cout << output;
+        _renderer.Present( output );
 
         if( ExitCondition( { !player.active, !AI.active, flee } ) )
         {
@@ -109,14 +108,13 @@ std::string BattleSystem::TurnPlayer( Character& player, Character& enemy, std::
     {
         std::string selection( print );
 
-        ClearScreen( _clearOutput );
         selection
             .append( "[0] Flee\n" )
             .append( "[1] Attack with weapon\n" )
             .append( "[2] Attack with spell\n" )
             .append( "Select action: \n" );
-        std::cout << selection;
-        input = SelectChar( { '0', '1', '2' } );
+        _renderer.Present( selection );
+        input = SelectChar( _input, { '0', '1', '2' } );
         selection
             .append( std::string( 1, input ) )
             .append( "\n" );
@@ -127,7 +125,7 @@ std::string BattleSystem::TurnPlayer( Character& player, Character& enemy, std::
             {
                 events
                     .append( "- " )
-                    .append( player.name )
+                    .append( player.type.name )
                     .append( " attempt to flee!\n" );
                 flee = true;
 
@@ -144,9 +142,8 @@ std::string BattleSystem::TurnPlayer( Character& player, Character& enemy, std::
                     const Spell* spell;
                     Character* target;
 
-                    ClearScreen( _clearOutput );
-                    std::cout << selection;
-                    SelectSpell( spell, GetSpells( player.spells ) );
+                    _renderer.Present( selection );
+                    SelectSpell( spell, GetSpells( player.type.spells ) );
 
                     if( !spell )
                     {
@@ -185,7 +182,7 @@ std::string BattleSystem::UpdateEffects( Character& character ) const
                 .append( "- " )
                 .append( it->second.name )
                 .append( " affects " )
-                .append( character.name )
+                .append( character.type.name )
                 .append( ", damaging its health by " )
                 .append( std::to_string( result ) )
                 .append( "\n" );
@@ -198,7 +195,7 @@ std::string BattleSystem::UpdateEffects( Character& character ) const
                 .append( "- " )
                 .append( it->second.name )
                 .append( " fades from " )
-                .append( character.name )
+                .append( character.type.name )
                 .append( "\n" );
             it = character.effects.erase( it );
         }
@@ -221,7 +218,7 @@ std::string BattleSystem::DisplayDetail( const Spell& spell ) const
         .append( "\n- Effects: " )
         .append( spell.effects ? GetStringEffects( GetEffects( spell.effects ) ) : std::string( "-" ) )
         .append( "\n" );
-    std::cout << output;
+    _renderer.Print( output );
 
     return output;
 }
@@ -246,15 +243,15 @@ std::string BattleSystem::SelectTarget( Character*& target, const std::vector<Ch
             .append( "[" )
             .append( std::string( 1, option ) )
             .append( "] " )
-            .append( targets[i]->name )
+            .append( targets[i]->type.name )
             .append( "\n" );
         mapped.emplace( option, targets[i] );
         valid.push_back( option );
     }
 
     output.append( "Select target: \n" );
-    std::cout << output;
-    select = SelectChar( valid );
+    _renderer.Print( output );
+    select = SelectChar( _input, valid );
     output
         .append( std::string( 1, select ) )
         .append( "\n" );
@@ -290,8 +287,8 @@ std::string BattleSystem::SelectSpell( const Spell*& spell, const std::vector<st
     }
 
     output.append( "Select target: \n" );
-    std::cout << output;
-    select = SelectChar( valid );
+    _renderer.Print( output );
+    select = SelectChar( _input, valid );
     output
         .append( std::string( 1, select ) )
         .append( "\n" );
@@ -305,11 +302,11 @@ std::string BattleSystem::AttackSpell( Character& attacker, Character& target, c
 
     events
         .append( "- " )
-        .append( attacker.name )
+        .append( attacker.type.name )
         .append( " cast " )
         .append( spell.name )
         .append( " on " )
-        .append( target.name );
+        .append( target.type.name );
 
     if( spell.power )
     {
@@ -334,7 +331,7 @@ std::string BattleSystem::AttackSpell( Character& attacker, Character& target, c
             .append( "- " )
             .append( spell.name )
             .append( " affects " )
-            .append( target.name )
+            .append( target.type.name )
             .append( ", applying " )
             .append( GetStringEffects( effects ) )
             .append( "\n" );
@@ -349,14 +346,14 @@ std::string BattleSystem::AttackSpell( Character& attacker, Character& target, c
 }
 std::string BattleSystem::AttackMelee( Character& attacker, Character& target ) const
 {
-    const int result = attacker.damage;
+    const int result = attacker.type.damage;
     std::string events;
 
     events
         .append( "- " )
-        .append( attacker.name )
+        .append( attacker.type.name )
         .append( " attack " )
-        .append( target.name )
+        .append( target.type.name )
         .append( ", damaging its health by " )
         .append( std::to_string( result ) )
         .append( "\n" );
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Renderer.h"
+#include "InputSource.h"
 #include <vector>
 #include <string>
 #include <map>
@@ -52,7 +54,7 @@ struct Spell
 class BattleSystem
 {
     public:
-        BattleSystem( bool clear );
+        BattleSystem( Renderer& renderer, InputSource& input );
 
         void Encounter( Character& player, Character& enemy ) const;
         std::string TurnPlayer( Character& player, Character& enemy, std::string_view print, bool& flee ) const;
@@ -68,7 +70,8 @@ class BattleSystem
 
 
     private:
-        const bool _clearOutput;
+        Renderer& _renderer;
+        InputSource& _input;
         const std::map<int, Effect> _effects;
         const std::map<int, Spell> _spells;
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "Bitboard.h"
+#include <array>
+
+Bitboard::Bitboard( const Vector2<int>& size ) :
+    _size( size ),
+    _words( ( size.x + 63 ) / 64 ),
+    _data( static_cast<std::size_t>( _words ) * size.y, 0 )
+{ }
+
+bool Bitboard::Get( const Vector2<int>& position ) const
+{
+    return ( Row( position.y )[position.x / 64] >> ( position.x % 64 ) ) & 1;
+}
+void Bitboard::Set( const Vector2<int>& position, bool value )
+{
+    const std::uint64_t bit = std::uint64_t( 1 ) << ( position.x % 64 );
+    std::uint64_t& word = Row( position.y )[position.x / 64];
+
+    word = value ? word | bit : word & ~bit;
+}
+int Bitboard::Neighbours( const Vector2<int>& position ) const
+{
+    static constexpr std::array<Vector2<int>, 8> directions
+    { {
+        {  0, -1 },
+        {  1, -1 },
+        {  1,  0 },
+        {  1,  1 },
+        {  0,  1 },
+        { -1,  1 },
+        { -1,  0 },
+        { -1, -1 }
+    } };
+    int count = 0;
+
+    for( const auto& direction : directions )
+    {
+        const Vector2<int> neighbour = position + direction;
+
+        if( neighbour.x >= 0 && neighbour.x < _size.x &&
+            neighbour.y >= 0 && neighbour.y < _size.y &&
+            Get( neighbour ) )
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+void Bitboard::NeighboursAtLeast( int threshold, Bitboard& result, int rowBegin, int rowEnd ) const
+{
+    /*
+        Counts the eight neighbours of 64 cells at a time. The neighbour rows are shifted
+        into place and summed with a bit-sliced ripple adder, count bit n of every cell
+        lives in word sum[n]. Rows outside the board count as empty.
+    */
+    const std::vector<std::uint64_t> empty( _words, 0 );
+    const std::uint64_t edge = _size.x % 64 ? ( std::uint64_t( 1 ) << ( _size.x % 64 ) ) - 1 : ~std::uint64_t( 0 );
+
+    for( int y = rowBegin; y < rowEnd; y++ )
+    {
+        const std::array<const std::uint64_t*, 3> rows
+        {
+            y > 0 ? Row( y - 1 ) : empty.data( ),
+            Row( y ),
+            y + 1 < _size.y ? Row( y + 1 ) : empty.data( )
+        };
+        std::uint64_t* output = result.Row( y );
+
+        for( int i = 0; i < _words; i++ )
+        {
+            std::array<std::uint64_t, 4> sum = { 0, 0, 0, 0 };
+            auto Add = [&sum] ( std::uint64_t value )
+            {
+                for( auto& bit : sum )
+                {
+                    const std::uint64_t carry = bit & value;
+
+                    bit ^= value;
+                    value = carry;
+                }
+            };
+
+            for( int r = 0; r < 3; r++ )
+            {
+                const std::uint64_t* row = rows[r];
+
+                Add( ( row[i] << 1 ) | ( i > 0 ? row[i - 1] >> 63 : 0 ) );
+                Add( ( row[i] >> 1 ) | ( i + 1 < _words ? row[i + 1] << 63 : 0 ) );
+
+                if( r != 1 )
+                {
+                    Add( row[i] );
+                }
+            }
+
+            std::uint64_t matches = 0;
+
+            for( int count = threshold; count <= 8; count++ )
+            {
+                std::uint64_t equal = ~std::uint64_t( 0 );
+
+                for( int n = 0; n < 4; n++ )
+                {
+                    equal &= ( count >> n ) & 1 ? sum[n] : ~sum[n];
+                }
+
+                matches |= equal;
+            }
+
+            output[i] = i + 1 < _words ? matches : matches & edge;
+        }
+    }
+}
+
+const Vector2<int>& Bitboard::Size( ) const
+{
+    return _size;
+}
+int Bitboard::Words( ) const
+{
+    return _words;
+}
+const std::uint64_t* Bitboard::Row( int y ) const
+{
+    return _data.data( ) + static_cast<std::size_t>( y ) * _words;
+}
+std::uint64_t* Bitboard::Row( int y )
+{
+    return _data.data( ) + static_cast<std::size_t>( y ) * _words;
+}
\ No newline at end of file
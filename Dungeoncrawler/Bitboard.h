@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Vector2.h"
+#include <vector>
+#include <cstdint>
+
+class Bitboard
+{
+    /*
+        Grid of bits packed 64 to a word, each row starts on a fresh word.
+        Bits past the right edge of a row are always kept cleared.
+    */
+
+    public:
+        Bitboard( const Vector2<int>& size );
+
+        bool Get( const Vector2<int>& position ) const;
+        void Set( const Vector2<int>& position, bool value );
+        int Neighbours( const Vector2<int>& position ) const;
+        void NeighboursAtLeast( int threshold, Bitboard& result, int rowBegin, int rowEnd ) const;
+
+        const Vector2<int>& Size( ) const;
+        int Words( ) const;
+        const std::uint64_t* Row( int y ) const;
+        std::uint64_t* Row( int y );
+
+    private:
+        Vector2<int> _size;
+        int _words;
+        std::vector<std::uint64_t> _data;
+};
\ No newline at end of file
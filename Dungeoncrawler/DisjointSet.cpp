@@ -0,0 +1,41 @@
+#include "DisjointSet.h"
+#include <numeric>
+#include <utility>
+
+DisjointSet::DisjointSet( int size ) :
+    _parents( size ),
+    _sizes( size, 1 )
+{
+    std::iota( _parents.begin( ), _parents.end( ), 0 );
+}
+
+int DisjointSet::Find( int element )
+{
+    while( _parents[element] != element )
+    {
+        _parents[element] = _parents[_parents[element]];
+        element = _parents[element];
+    }
+
+    return element;
+}
+bool DisjointSet::Unite( int a, int b )
+{
+    a = Find( a );
+    b = Find( b );
+
+    if( a == b )
+    {
+        return false;
+    }
+
+    if( _sizes[a] < _sizes[b] )
+    {
+        std::swap( a, b );
+    }
+
+    _parents[b] = a;
+    _sizes[a] += _sizes[b];
+
+    return true;
+}
\ No newline at end of file
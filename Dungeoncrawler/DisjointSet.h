@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+class DisjointSet
+{
+    /*
+        Union-find over the elements 0 to size - 1.
+        Union by size and path halving keep every operation close to constant time.
+    */
+
+    public:
+        DisjointSet( int size );
+
+        int Find( int element );
+        bool Unite( int a, int b );
+
+    private:
+        std::vector<int> _parents;
+        std::vector<int> _sizes;
+};
\ No newline at end of file
@@ -1,17 +1,73 @@
 #include "Dungeon.h"
 #include "Functions.h"
 #include "AStarAlgorithm.h"
+#include "Bitboard.h"
+#include "ThreadPool.h"
+#include "DisjointSet.h"
 #include <algorithm>
 #include <random>
 #include <cmath>
 #include <map>
 #include <optional>
 #include <memory>
+#include <thread>
+#include <deque>
+#include <limits>
+#include <chrono>
+
+namespace
+{
+    /* Generation splits the grid into bands of rows, fixed so results never depend on the thread count */
+    constexpr int TileRows = 32;
+
+    /* Energy an action costs, a speed of 100 acts once per player turn of the same speed */
+    constexpr std::int64_t ActionEnergy = 10000;
+
+    std::int64_t ActionDelay( const Entity* entity )
+    {
+        const Character* character = EntityCast<Character>( entity );
+
+        /* At least one tick, a zero delay would reschedule an actor into the turn it just took */
+        return std::max<std::int64_t>( 1, ActionEnergy / std::max( 1, character ? character->speed : 100 ) );
+    }
+
+    enum Stream : std::uint64_t
+    {
+        StreamWallsParents = 1ull << 32,
+        StreamEnemies      = 2ull << 32
+    };
+
+    std::vector<int> Apportion( int total, const std::vector<int>& capacities )
+    {
+        /* Splits total proportionally to capacities, never handing a tile more than it holds */
+        std::vector<int> shares( capacities.size( ), 0 );
+        std::int64_t capacity = 0;
+        std::int64_t prefix = 0;
+
+        for( int value : capacities )
+        {
+            capacity += value;
+        }
+
+        total = static_cast<int>( std::min<std::int64_t>( total, capacity ) );
+
+        for( std::size_t i = 0; i < capacities.size( ); i++ )
+        {
+            const std::int64_t before = capacity ? total * prefix / capacity : 0;
+
+            prefix += capacities[i];
+            shares[i] = static_cast<int>( ( capacity ? total * prefix / capacity : 0 ) - before );
+        }
+
+        return shares;
+    }
+}
 
 DungeonConfiguration::DungeonConfiguration( ) :
     size( { false, { 0, 0 } } ),
-    generate( { true, true, true, true, true, true, true } ),
-    amount( { 0, 0, 0, 0, 0 } )
+    generate( { true, true, false, true, true, true, true, true } ),
+    amount( { 0, 0, 0, 0, 0 } ),
+    options( { false, std::max( 1, static_cast<int>( std::thread::hardware_concurrency( ) ) ), Layout::Caves } )
 { }
 DungeonConfiguration::DungeonConfiguration( const std::vector<std::string>& data )
 {
@@ -29,42 +85,71 @@ DungeonConfiguration::DungeonConfiguration( const std::vector<std::string>& data
     amount.wallsChildren     = std::stoi( data[12] );
     amount.wallsFillerCycles = std::stoi( data[13] );
     amount.enemies           = std::stoi( data[14] );
+
+    /* Configurations saved before the option existed were generated in place */
+    options.wallsFillerInPlace = data.size( ) > 15 ? std::stoi( data[15] ) != 0 : true;
+    options.threads = DungeonConfiguration( ).options.threads;
+    generate.connectivity = data.size( ) > 16 ? std::stoi( data[16] ) != 0 : false;
+    options.layout = data.size( ) > 17 ? static_cast<Layout::Enum>( std::stoi( data[17] ) ) : Layout::Caves;
 }
 
-Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const DungeonConfiguration& config ) :
-    _grid( [&config]( )
+Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const DungeonConfiguration& config, std::uint64_t seed ) :
+    _rng( seed ),
+    _threads( std::max( 1, config.options.threads ) ),
+    _timings( { } ),
+    _grid( [this, &config]( )
     {
         constexpr int min = 30;
         constexpr int max = 50;
         const Vector2<int> random
         {
-            GetRNG( min, max ),
-            GetRNG( min, max )
+            _rng.Get( min, max ),
+            _rng.Get( min, max )
         };
 
         return config.size.determined ? config.size.dungeon : random;
     }( ) ),
-    _player( player )
+    _icons( _grid.Size( ), '-' ),
+    _visionMask( _grid.Size( ), 0 ),
+    _time( 0 ),
+    _player( player ),
+    _entityFactory( entityFactory )
 {
-    if( config.generate.doors )         GenerateDoors( entityFactory, config.amount.doors );
-    if( config.generate.wallsOuter )    GenerateWallsOuter( entityFactory );
-    if( config.generate.hiddenPath )    GenerateHiddenPath( entityFactory );
-    if( config.generate.wallsParents )  GenerateWallsParents( entityFactory, config.amount.wallsParents );
-    if( config.generate.wallsChildren ) GenerateWallsChildren( entityFactory, config.amount.wallsChildren );
-    if( config.generate.wallsFiller )   GenerateWallsFiller( entityFactory, config.amount.wallsFillerCycles );
-    if( config.generate.enemies )       GenerateEnemies( entityFactory, config.amount.enemies );
+    if( config.generate.doors )         Timed( Stage::Doors,         [&] { GenerateDoors( config.amount.doors ); } );
+
+    if( config.options.layout == Layout::Rooms )
+    {
+        Timed( Stage::Rooms, [&] { GenerateRooms( ); } );
+    }
+    else
+    {
+        if( config.generate.wallsOuter )    Timed( Stage::WallsOuter,    [&] { GenerateWallsOuter( ); } );
+        if( config.generate.hiddenPath )    Timed( Stage::HiddenPath,    [&] { GenerateHiddenPath( ); } );
+        if( config.generate.wallsParents )  Timed( Stage::WallsParents,  [&] { GenerateWallsParents( config.amount.wallsParents ); } );
+        if( config.generate.wallsChildren ) Timed( Stage::WallsChildren, [&] { GenerateWallsChildren( config.amount.wallsChildren ); } );
+        if( config.generate.wallsFiller )   Timed( Stage::WallsFiller,   [&] { GenerateWallsFiller( config.amount.wallsFillerCycles, config.options.wallsFillerInPlace ); } );
+        if( config.generate.connectivity )  Timed( Stage::Connectivity,  [&] { GenerateConnectivity( ); } );
+    }
+
+    if( config.generate.enemies )       Timed( Stage::Enemies,       [&] { GenerateEnemies( config.amount.enemies ); } );
 }
-Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const Grid<char>& icons, const std::vector<Door>& doors ) :
+Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const Grid<char>& icons, const std::vector<Door>& doors, std::uint64_t seed ) :
+    _rng( seed ),
+    _threads( 1 ),
+    _timings( { } ),
     _grid( icons.Size( ) ),
-    _player( player )
+    _icons( _grid.Size( ), '-' ),
+    _visionMask( _grid.Size( ), 0 ),
+    _time( 0 ),
+    _player( player ),
+    _entityFactory( entityFactory )
 {
     std::optional<Vector2<int>> positionPlayer;
     Vector2<int> iterator;
 
     for( const auto& door : doors )
     {
-        EntityInsert( door.position, door.Clone( ) );
-        _indexDoors.push_back( _entities.size( ) - 1 );
+        EntityInsert( door.position, door.Clone( _arena ) );
     }
 
     for( iterator.y = 0; iterator.y < _grid.Size( ).y; iterator.y++ )
@@ -74,13 +159,19 @@ Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, cons
             if( icons[iterator] != '-' &&
                 icons[iterator] != '+' )
             {
+                const Terrain::Enum terrain = entityFactory.GetTerrain( icons[iterator] );
+
                 if( icons[iterator] == '@' )
                 {
                     positionPlayer = iterator;
                 }
+                else if( terrain != Terrain::None )
+                {
+                    TerrainInsert( iterator, terrain );
+                }
                 else
                 {
-                    EntityInsert( iterator, entityFactory.Get( icons[iterator] )->Clone( ) );
+                    EntityInsert( iterator, entityFactory.Get( icons[iterator] )->Clone( _arena ) );
                 }
             }
         }
@@ -96,7 +187,7 @@ Dungeon::Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, cons
 
 void Dungeon::Connect( const Connector& connector, int index )
 {
-    dynamic_cast<Door*>( _entities[_indexDoors[index]].get( ) )->connector = connector;
+    EntityCast<Door>( _entities.Get( _indexDoors[index] ) )->connector = connector;
 }
 void Dungeon::PlayerSet( const std::optional<int>& index )
 {
@@ -112,7 +203,7 @@ void Dungeon::PlayerSet( const std::optional<int>& index )
     {
         for( const auto& direction : directions )
         {
-            const Vector2<int> neighbour = _entities[_indexDoors[*index]]->position + direction;
+            const Vector2<int> neighbour = _entities.Get( _indexDoors[*index] )->position + direction;
 
             if( InBounds( neighbour, _grid.Size( ) ) &&
                 TileLacking( neighbour, Attributes::Obstacle ) )
@@ -136,12 +227,26 @@ void Dungeon::Events( const BattleSystem& battleSystem )
     /* Fight hostile entities on player position */
     for( auto& entity : _grid[_player.real->position].occupants )
     {
-        if( entity->attributes & Attributes::Hostile )
+        if( entity->type.attributes & Attributes::Hostile )
         {
-            Character* enemy = dynamic_cast<Character*>( entity );
+            Character* enemy = EntityCast<Character>( entity );
+            const std::optional<int> found = _entities.Find( enemy );
+
+            if( !enemy || !found )
+            {
+                continue;
+            }
+
+            const int index = *found;
 
             battleSystem.Encounter( *_player.real, *enemy );
-            _grid[_player.real->position].icon = _player.real->icon;
+            _entities.Pull( index );
+            _icons[_player.real->position] = _player.real->type.icon;
+
+            if( !_entities.Active( )[index] )
+            {
+                _dead.push_back( _entities.Handle( index ) );
+            }
         }
     }
 
@@ -152,35 +257,29 @@ void Dungeon::Events( const BattleSystem& battleSystem )
     }
 
 
-    /* Remove dead entities */
-    for( unsigned int i = 0; i < _entities.size( ); i++ )
+    /* Remove entities that died this turn in one batch */
+    if( !_dead.empty( ) )
     {
-        if( !_entities[i]->active )
-        {
-            const Vector2<int> position = _entities[i]->position;
-
-            EntityRemove( i );
-            UpdateTile( position );
-        }
+        EntityRemove( _dead );
+        _dead.clear( );
     }
 }
 void Dungeon::Rotate( Orientation orientation )
 {
-    std::unordered_set<Vector2<int>, HasherVector2<int>> vision;
-
-    for( const auto& position : _vision )
+    for( auto& position : _vision )
     {
-        vision.insert( PositionRotate( position, _grid.Size( ), orientation ) );
+        position = PositionRotate( position, _grid.Size( ), orientation );
     }
 
-    for( auto& entity : _entities )
+    for( int i = 0, limit = _entities.Size( ); i < limit; i++ )
     {
-        entity->position = PositionRotate( entity->position, _grid.Size( ), orientation );
+        _entities.Move( i, PositionRotate( _entities.Positions( )[i], _grid.Size( ), orientation ) );
     }
 
     _player.real->position = PositionRotate( _player.real->position, _grid.Size( ), orientation );
-    _vision = std::move( vision );
     _grid.Rotate( orientation );
+    _icons.Rotate( orientation );
+    _visionMask.Rotate( orientation );
 }
 void Dungeon::MovementPlayer( Orientation orientation )
 {
@@ -188,6 +287,11 @@ void Dungeon::MovementPlayer( Orientation orientation )
 
     if( InBounds( moving, _grid.Size( ) ) )
     {
+        if( _grid[moving].terrain != Terrain::None )
+        {
+            _entityFactory.Get( _grid[moving].terrain )->Interact( *_player.real );
+        }
+
         for( auto& entity : _grid[moving].occupants )
         {
             entity->Interact( *_player.real );
@@ -205,22 +309,50 @@ void Dungeon::MovementPlayer( Orientation orientation )
 
     BuildVision( _player.real->position, _player.real->visionReach );
 }
-void Dungeon::MovementRandom( )
+void Dungeon::Advance( )
 {
-    for( int i = 0, limit = _entities.size( ); i < limit; i++ )
+    /*
+        Moves the dungeon clock forward by one player action and lets every actor whose turn
+        has come act, fast actors possibly several times. The schedule is ordered by action
+        time with one bucket per time, actors sharing a speed share buckets, so only actors
+        that act are touched. Removed entities leave stale handles behind that are dropped
+        when their bucket comes due.
+    */
+    const std::vector<Entity*>& entities = _entities.Entities( );
+    const std::vector<Vector2<int>>& positions = _entities.Positions( );
+
+    _time += ActionDelay( _player.real );
+
+    while( !_schedule.empty( ) &&
+           _schedule.begin( )->first <= _time )
     {
-        if( _entities[i]->attributes & Attributes::Movement )
+        const std::int64_t time = _schedule.begin( )->first;
+
+        _due.swap( _schedule.begin( )->second );
+        _schedule.erase( _schedule.begin( ) );
+
+        for( const auto& handle : _due )
         {
-            const Vector2<int> moving = PositionMoveProbability( _entities[i]->position, 1, 1, 1, 1, 12 );
+            if( !_entities.Valid( handle ) )
+            {
+                continue;
+            }
+
+            const int i = _entities.Index( handle );
+            const Vector2<int> moving = PositionMoveProbability( _rng, positions[i], 1, 1, 1, 1, 12 );
 
             if( InBounds( moving, _grid.Size( ) ) &&
                 TileLacking( moving, Attributes::Obstacle ) )
             {
-                OccupantRemove( _entities[i]->position, _entities[i].get( ) );
-                _entities[i]->position = moving;
-                OccupantInsert( _entities[i]->position, _entities[i].get( ) );
+                OccupantRemove( positions[i], entities[i] );
+                _entities.Move( i, moving );
+                OccupantInsert( positions[i], entities[i] );
             }
+
+            _schedule[time + ActionDelay( entities[i] )].push_back( handle );
         }
+
+        _due.clear( );
     }
 }
 
@@ -228,34 +360,55 @@ const Vector2<int>& Dungeon::GetSize( ) const
 {
     return _grid.Size( );
 }
+const std::array<double, Stage::Count>& Dungeon::GetTimings( ) const
+{
+    return _timings;
+}
 const std::vector<Door*> Dungeon::GetDoors( ) const
 {
     std::vector<Door*> doors;
 
     for( auto i : _indexDoors )
     {
-        doors.push_back( dynamic_cast<Door*>( _entities[i].get( ) ) );
+        doors.push_back( EntityCast<Door>( _entities.Get( i ) ) );
     }
 
     return doors;
 }
 char Dungeon::GetIcon( const Vector2<int>& position ) const
 {
-    return _grid[position].icon;
+    return _icons[position];
 }
 bool Dungeon::Visible( const Vector2<int>& position ) const
 {
-    return _vision.find( position ) != _vision.end( );
+    return _visionMask[position] != 0;
+}
+const char* Dungeon::GetIconRow( int y ) const
+{
+    return &_icons[static_cast<std::size_t>( y ) * _icons.Size( ).x];
+}
+const char* Dungeon::GetVisionRow( int y ) const
+{
+    /* Visible cells hold all bits set and hidden cells none, usable as a select mask */
+    return &_visionMask[static_cast<std::size_t>( y ) * _visionMask.Size( ).x];
 }
 bool Dungeon::Unoccupied( const Vector2<int>& position ) const
 {
-    return _grid[position].occupants.empty( );
+    return
+        _grid[position].terrain == Terrain::None &&
+        _grid[position].occupants.empty( );
 }
 bool Dungeon::TileLacking( const Vector2<int>& position, int bitmask ) const
 {
+    if( _grid[position].terrain != Terrain::None &&
+        _entityFactory.Get( _grid[position].terrain )->type.attributes & bitmask )
+    {
+        return false;
+    }
+
     for( const auto& entity : _grid[position].occupants )
     {
-        if( entity->attributes & bitmask )
+        if( entity->type.attributes & bitmask )
         {
             return false;
         }
@@ -266,10 +419,30 @@ bool Dungeon::TileLacking( const Vector2<int>& position, int bitmask ) const
 
 void Dungeon::UpdateTile( const Vector2<int>& position )
 {
-    _grid[position].icon = _grid[position].occupants.empty( ) ? '-' : _grid[position].occupants.back( )->icon;
+    const Tile& tile = _grid[position];
+    char& icon = _icons[position];
+
+    if( !tile.occupants.empty( ) )
+    {
+        icon = tile.occupants.back( )->type.icon;
+    }
+    else if( tile.terrain != Terrain::None )
+    {
+        icon = _entityFactory.Get( tile.terrain )->type.icon;
+    }
+    else
+    {
+        icon = '-';
+    }
 }
 void Dungeon::BuildVision( const Vector2<int>& position, int visionReach )
 {
+    /* Reset only the cells seen last turn rather than the whole mask */
+    for( const auto& visible : _vision )
+    {
+        _visionMask[visible] = 0;
+    }
+
     _vision.clear( );
 
     for( const auto& endpoint : BresenhamCircle( position, visionReach * 10 ) )
@@ -285,6 +458,16 @@ void Dungeon::BuildVision( const Vector2<int>& position, int visionReach )
     //FixVisionNearbyWalls( position, visionReach );
     //FixVisionDeadspots( position );
 }
+void Dungeon::See( const Vector2<int>& position )
+{
+    char& mask = _visionMask[position];
+
+    if( !mask )
+    {
+        mask = ~0;
+        _vision.push_back( position );
+    }
+}
 void Dungeon::FixVisionNearbyWalls( const Vector2<int>& position, int visionReach )
 {
     static constexpr std::array<Vector2<int>, 4> directions
@@ -309,7 +492,7 @@ void Dungeon::FixVisionNearbyWalls( const Vector2<int>& position, int visionReac
                 if( InBounds( adjacent, _grid.Size( ) ) &&
                     !TileLacking( adjacent, Attributes::Obstacle ) )
                 {
-                    _vision.insert( adjacent );
+                    See( adjacent );
                 }
 
                 if( InBounds( current, _grid.Size( ) ) &&
@@ -331,8 +514,10 @@ void Dungeon::FixVisionDeadspots( const Vector2<int>& position )
         { { -1,  0 }, { { -1,  1 }, { -1, -1 } } }
     } };
 
-    for( const auto& visible : _vision )
+    for( std::size_t i = 0, limit = _vision.size( ); i < limit; i++ )
     {
+        const Vector2<int> visible = _vision[i];
+
         for( const auto& neighbour : neighbours )
         {
             const Vector2<int> adjacent = visible + neighbour.first;
@@ -369,7 +554,7 @@ void Dungeon::LineOfSight( const std::vector<Vector2<int>>& path, int visionReac
             break;
         }
 
-        _vision.insert( current );
+        See( current );
 
         if( !TileLacking( current, Attributes::Obstacle ) )
         {
@@ -386,7 +571,7 @@ void Dungeon::LineOfSight( const std::vector<Vector2<int>>& path )
             break;
         }
 
-        _vision.insert( current );
+        See( current );
 
         if( !TileLacking( current, Attributes::Obstacle ) )
         {
@@ -407,33 +592,89 @@ void Dungeon::OccupantRemove( const Vector2<int>& position, Entity* entity )
         _grid[position].occupants.end( ) );
     UpdateTile( position );
 }
-void Dungeon::EntityInsert( const Vector2<int>& position, Entity* entity )
+EntityHandle Dungeon::EntityInsert( const Vector2<int>& position, Entity* entity )
 {
-    _entities.emplace_back( entity );
-    _entities.back( )->position = position;
+    /* Entity is owned by _arena and lives until the whole dungeon is released */
+    const EntityHandle handle = _entities.Insert( entity, position );
+
+    if( entity->kind & Kind::Door )                      _indexDoors.push_back( handle );
+    if( entity->type.attributes & Attributes::Movement ) _schedule[_time + ActionDelay( entity )].push_back( handle );
+
     OccupantInsert( position, entity );
+
+    return handle;
 }
-void Dungeon::EntityRemove( int index )
+void Dungeon::EntityRemove( const std::vector<EntityHandle>& handles )
 {
-    if( index == _entities.size( ) - 1 )
+    for( const auto& handle : handles )
     {
-        OccupantRemove( _entities[index]->position, _entities[index].get( ) );
-        _entities.pop_back( );
+        if( _entities.Valid( handle ) )
+        {
+            const int index = _entities.Index( handle );
+
+            OccupantRemove( _entities.Positions( )[index], _entities.Entities( )[index] );
+        }
     }
-    else
+
+    _entities.Remove( handles );
+    _indexDoors.erase( std::remove_if( _indexDoors.begin( ), _indexDoors.end( ), [this] ( const EntityHandle& handle )
     {
-        OccupantRemove( _entities[index]->position, _entities[index].get( ) );
-        OccupantRemove( _entities.back( )->position, _entities.back( ).get( ) );
-        std::swap( _entities[index], _entities.back( ) );
-        _entities.pop_back( );
-        OccupantInsert( _entities[index]->position, _entities[index].get( ) );
+        return !_entities.Valid( handle );
+    } ), _indexDoors.end( ) );
+}
+void Dungeon::TerrainInsert( const Vector2<int>& position, Terrain::Enum terrain )
+{
+    _grid[position].terrain = terrain;
+    UpdateTile( position );
+}
+PositionSampler Dungeon::UnoccupiedInterior( int rowBegin, int rowEnd ) const
+{
+    /*
+        Placement draws from this instead of retrying random tiles, so a full map cannot stall it.
+        Positions are relative to rowBegin so a band only pays for its own rows.
+    */
+    PositionSampler unoccupied( { _grid.Size( ).x, rowEnd - rowBegin } );
+    Vector2<int> iterator;
+
+    for( iterator.y = std::max( rowBegin, 1 ); iterator.y < std::min( rowEnd, _grid.Size( ).y - 1 ); iterator.y++ )
+    {
+        for( iterator.x = 1; iterator.x < _grid.Size( ).x - 1; iterator.x++ )
+        {
+            if( Unoccupied( iterator ) )
+            {
+                unoccupied.Insert( { iterator.x, iterator.y - rowBegin } );
+            }
+        }
     }
+
+    return unoccupied;
+}
+int Dungeon::TileCount( ) const
+{
+    return ( _grid.Size( ).y + TileRows - 1 ) / TileRows;
+}
+void Dungeon::TileParallel( const std::function<void( int tile, int rowBegin, int rowEnd )>& body )
+{
+    /* Bodies may only write tiles inside their own rows, rows outside are read only */
+    ParallelFor( TileCount( ), _threads, [this, &body] ( int tile )
+    {
+        body( tile, tile * TileRows, std::min( ( tile + 1 ) * TileRows, _grid.Size( ).y ) );
+    } );
 }
 
-void Dungeon::GenerateDoors( const EntityFactory& entityFactory, int amount )
+void Dungeon::Timed( Stage::Enum stage, const std::function<void( )>& function )
+{
+    /* Seconds spent in each generation stage, kept for the batch statistics */
+    const auto start = std::chrono::steady_clock::now( );
+
+    function( );
+
+    _timings[stage] = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - start ).count( );
+}
+void Dungeon::GenerateDoors( int amount )
 {
     const int limit = amount ? amount : 3;
-    const int start = GetRNG( 0, 3 );
+    const int start = _rng.Get( 0, 3 );
     const int cornerOffset = static_cast<int>( std::ceil( ( std::sqrt( _grid.Size( ).x * _grid.Size( ).y ) + 6.0 ) / 10.0 ) - 1.0 );
     std::map<Orientation, std::vector<Vector2<int>>> valid;
     std::vector<Orientation> sides;
@@ -458,69 +699,66 @@ void Dungeon::GenerateDoors( const EntityFactory& entityFactory, int amount )
 
     for( const auto& side : sides )
     {
-        const int index = GetRNG( 0, valid[side].size( ) - 1 );
+        const int index = _rng.Get( 0, valid[side].size( ) - 1 );
 
-        EntityInsert( valid[side][index], entityFactory.Get( "Door" )->Clone( ) );
+        EntityInsert( valid[side][index], _entityFactory.Get( "Door" )->Clone( _arena ) );
         valid[side].erase( valid[side].begin( ) + index );
-        _indexDoors.push_back( _entities.size( ) - 1 );
     }
 }
-void Dungeon::GenerateWallsOuter( const EntityFactory& entityFactory )
+void Dungeon::GenerateWallsOuter( )
 {
-    Vector2<int> iterator;
-
-    for( iterator.y = 0; iterator.y < _grid.Size( ).y; iterator.y++ )
+    TileParallel( [this] ( int, int rowBegin, int rowEnd )
     {
-        for( iterator.x = 0; iterator.x < _grid.Size( ).x; iterator.x++ )
+        Vector2<int> iterator;
+
+        for( iterator.y = rowBegin; iterator.y < rowEnd; iterator.y++ )
         {
-            if( Unoccupied( iterator ) &&
-                OnBorder( iterator, _grid.Size( ) ) )
+            for( iterator.x = 0; iterator.x < _grid.Size( ).x; iterator.x++ )
             {
-                EntityInsert( iterator, entityFactory.Get( "Wall" )->Clone( ) );
+                if( Unoccupied( iterator ) &&
+                    OnBorder( iterator, _grid.Size( ) ) )
+                {
+                    TerrainInsert( iterator, Terrain::Wall );
+                }
             }
         }
-    }
+    } );
 }
-void Dungeon::GenerateHiddenPath( const EntityFactory& entityFactory )
+void Dungeon::GenerateHiddenPath( )
 {
     const Vector2<int> center = _grid.Size( ) / 2;
     std::vector<Vector2<int>> obstacles;
     std::vector<std::pair<Vector2<int>, Vector2<int>>> redirection;
-    auto PathAdd = [this, &entityFactory] ( const std::vector<Vector2<int>>& path )
+    Vector2<int> iterator;
+    auto PathAdd = [this] ( const std::vector<Vector2<int>>& path )
     {
         for( const auto& position : path )
         {
             if( Unoccupied( position ) )
             {
-                EntityInsert( position, entityFactory.Get( "Hidden" )->Clone( ) );
+                TerrainInsert( position, Terrain::Hidden );
             }
         }
     };
 
-    for( const auto& entity : _entities )
+    for( iterator.y = 0; iterator.y < _grid.Size( ).y; iterator.y++ )
     {
-        if( entity->attributes & Attributes::Obstacle )
+        for( iterator.x = 0; iterator.x < _grid.Size( ).x; iterator.x++ )
         {
-            obstacles.push_back( entity->position );
+            if( !TileLacking( iterator, Attributes::Obstacle ) )
+            {
+                obstacles.push_back( iterator );
+            }
         }
     }
 
+    const PositionSampler unoccupied = UnoccupiedInterior( 0, _grid.Size( ).y );
+
     for( const auto& door : GetDoors( ) )
     {
-        while( true )
+        if( !unoccupied.Empty( ) )
         {
-            const Vector2<int> random
-            {
-                GetRNG( 1, _grid.Size( ).x - 2 ),
-                GetRNG( 1, _grid.Size( ).y - 2 )
-            };
-
-            if( Unoccupied( random ) )
-            {
-                redirection.emplace_back( door->position, random );
-
-                break;
-            }
+            redirection.emplace_back( door->position, unoccupied.Sample( _rng ) );
         }
     }
 
@@ -530,26 +768,35 @@ void Dungeon::GenerateHiddenPath( const EntityFactory& entityFactory )
         PathAdd( AStarAlgorithm( pair.second,     center, _grid.Size( ), obstacles ) );
     }
 }
-void Dungeon::GenerateWallsParents( const EntityFactory& entityFactory, int amount )
+void Dungeon::GenerateWallsParents( int amount )
 {
-    int remaining = amount ? amount : ( _grid.Size( ).x * _grid.Size( ).y ) / 10;
+    /* Every tile scatters its share of the walls from its own random stream */
+    const int limit = amount ? amount : ( _grid.Size( ).x * _grid.Size( ).y ) / 10;
+    std::vector<PositionSampler> unoccupied( TileCount( ), PositionSampler( { 0, 0 } ) );
+    std::vector<int> capacities( TileCount( ) );
 
-    while( remaining > 0 )
+    TileParallel( [this, &unoccupied, &capacities] ( int tile, int rowBegin, int rowEnd )
     {
-        const Vector2<int> position
-        {
-            GetRNG( 1, _grid.Size( ).x - 2 ),
-            GetRNG( 1, _grid.Size( ).y - 2 )
-        };
+        unoccupied[tile] = UnoccupiedInterior( rowBegin, rowEnd );
+        capacities[tile] = unoccupied[tile].Size( );
+    } );
+
+    const std::vector<int> shares = Apportion( limit, capacities );
+
+    TileParallel( [this, &unoccupied, &shares] ( int tile, int rowBegin, int )
+    {
+        RandomGenerator generator = _rng.Split( StreamWallsParents | tile );
 
-        if( Unoccupied( position ) )
+        for( int i = 0; i < shares[tile]; i++ )
         {
-            EntityInsert( position, entityFactory.Get( "Wall" )->Clone( ) );
-            remaining--;
+            const Vector2<int> position = unoccupied[tile].Sample( generator );
+
+            TerrainInsert( { position.x, position.y + rowBegin }, Terrain::Wall );
+            unoccupied[tile].Erase( position );
         }
-    }
+    } );
 }
-void Dungeon::GenerateWallsChildren( const EntityFactory& entityFactory, int amount )
+void Dungeon::GenerateWallsChildren( int amount )
 {
     static const std::array<Vector2<int>, 4> directions
     { {
@@ -559,94 +806,509 @@ void Dungeon::GenerateWallsChildren( const EntityFactory& entityFactory, int amo
         { -1,  0 }
     } };
     int remaining = amount ? amount : ( _grid.Size( ).x * _grid.Size( ).y ) / 4;
+    PositionSampler frontier( _grid.Size( ) );
+    Vector2<int> iterator;
+    auto Expand = [this, &frontier] ( const Vector2<int>& position )
+    {
+        for( const auto& direction : directions )
+        {
+            const Vector2<int> neighbour = position + direction;
+
+            if( InBounds( neighbour, _grid.Size( ) ) &&
+                Unoccupied( neighbour ) )
+            {
+                frontier.Insert( neighbour );
+            }
+        }
+    };
+    auto Adjacent = [this] ( const Vector2<int>& position ) -> int
+    {
+        int count = 0;
+
+        for( const auto& direction : directions )
+        {
+            const Vector2<int> neighbour = position + direction;
+
+            if( InBounds( neighbour, _grid.Size( ) ) &&
+                !TileLacking( neighbour, Attributes::Obstacle ) )
+            {
+                count++;
+            }
+        }
+
+        return count;
+    };
+
+    for( iterator.y = 0; iterator.y < _grid.Size( ).y; iterator.y++ )
+    {
+        for( iterator.x = 0; iterator.x < _grid.Size( ).x; iterator.x++ )
+        {
+            if( !TileLacking( iterator, Attributes::Obstacle ) )
+            {
+                Expand( iterator );
+            }
+        }
+    }
+
+    /*
+        Free cells next to obstacles form the frontier. A cell is accepted with a chance
+        proportional to its obstacle neighbours, like picking an obstacle and then a direction.
+    */
+    while( remaining > 0 &&
+           !frontier.Empty( ) )
+    {
+        const Vector2<int> position = frontier.Sample( _rng );
+
+        if( _rng.Get( 1, directions.size( ) ) <= Adjacent( position ) )
+        {
+            TerrainInsert( position, Terrain::Wall );
+            frontier.Erase( position );
+            Expand( position );
+            remaining--;
+        }
+    }
+}
+void Dungeon::GenerateWallsFiller( int amount, bool inPlace )
+{
+    /*
+        Walls grow into free interior tiles with at least five obstacle neighbours.
+        The automaton runs on packed bitmaps and the grid is only touched once at the end.
+        In place mode updates tile by tile so later tiles see earlier results,
+        otherwise every cycle is computed from the previous one and applied at once.
+    */
+    const int limit = amount ? amount : 5;
+    const Vector2<int> size = _grid.Size( );
+    Bitboard obstacles( size );
+    Bitboard candidates( size );
 
-    while( remaining > 0 )
+    TileParallel( [this, &size, &obstacles, &candidates] ( int, int rowBegin, int rowEnd )
     {
-        for( int i = 0, limit = _entities.size( ); i < limit; i++ )
+        Vector2<int> iterator;
+
+        for( iterator.y = rowBegin; iterator.y < rowEnd; iterator.y++ )
         {
-            if( _entities[i]->attributes & Attributes::Obstacle )
+            for( iterator.x = 0; iterator.x < size.x; iterator.x++ )
             {
-                const int index = GetRNG( 0, directions.size( ) - 1 );
-                const Vector2<int> position = _entities[i]->position + directions[index];
+                const bool interior = iterator.x > 0 && iterator.x < size.x - 1 &&
+                                      iterator.y > 0 && iterator.y < size.y - 1;
+
+                obstacles.Set( iterator, !TileLacking( iterator, Attributes::Obstacle ) );
+                candidates.Set( iterator, interior && Unoccupied( iterator ) );
+            }
+        }
+    } );
+
+    const Bitboard initial = candidates;
 
-                if( InBounds( position, _grid.Size( ) ) &&
-                    Unoccupied( position ) )
+    if( inPlace )
+    {
+        Vector2<int> iterator;
+
+        for( int i = 0; i < limit; i++ )
+        {
+            for( iterator.y = 1; iterator.y < size.y - 1; iterator.y++ )
+            {
+                for( iterator.x = 1; iterator.x < size.x - 1; iterator.x++ )
                 {
-                    EntityInsert( position, entityFactory.Get( "Wall" )->Clone( ) );
-                    remaining--;
+                    if( candidates.Get( iterator ) &&
+                        obstacles.Neighbours( iterator ) >= 5 )
+                    {
+                        obstacles.Set( iterator, true );
+                        candidates.Set( iterator, false );
+                    }
                 }
             }
         }
     }
+    else
+    {
+        /* Tiles read the rows just above and below their band, so counting finishes everywhere before growing */
+        Bitboard surrounded( size );
+
+        for( int i = 0; i < limit; i++ )
+        {
+            TileParallel( [&obstacles, &surrounded] ( int, int rowBegin, int rowEnd )
+            {
+                obstacles.NeighboursAtLeast( 5, surrounded, rowBegin, rowEnd );
+            } );
+
+            TileParallel( [&obstacles, &candidates, &surrounded] ( int, int rowBegin, int rowEnd )
+            {
+                for( int y = rowBegin; y < rowEnd; y++ )
+                {
+                    std::uint64_t* rowObstacles = obstacles.Row( y );
+                    std::uint64_t* rowCandidates = candidates.Row( y );
+                    const std::uint64_t* rowSurrounded = surrounded.Row( y );
+
+                    for( int w = 0; w < obstacles.Words( ); w++ )
+                    {
+                        const std::uint64_t grown = rowCandidates[w] & rowSurrounded[w];
+
+                        rowObstacles[w] |= grown;
+                        rowCandidates[w] &= ~grown;
+                    }
+                }
+            } );
+        }
+    }
+
+    TileParallel( [this, &size, &initial, &candidates] ( int, int rowBegin, int rowEnd )
+    {
+        Vector2<int> iterator;
+
+        for( iterator.y = rowBegin; iterator.y < rowEnd; iterator.y++ )
+        {
+            for( iterator.x = 0; iterator.x < size.x; iterator.x++ )
+            {
+                if( initial.Get( iterator ) &&
+                    !candidates.Get( iterator ) )
+                {
+                    TerrainInsert( iterator, Terrain::Wall );
+                }
+            }
+        }
+    } );
 }
-void Dungeon::GenerateWallsFiller( const EntityFactory& entityFactory, int amount )
+void Dungeon::GenerateConnectivity( )
 {
-    const int limit = amount ? amount : 5;
+    /*
+        Open tiles are labeled into regions with union-find. Every door still cut off from the
+        center runs a 0-1 search where open tiles cost nothing and interior walls cost one,
+        the first tile reached in the center region ends the cheapest bridge, which is carved.
+    */
+    static constexpr std::array<Vector2<int>, 4> directions
+    { {
+        {  0, -1 },
+        {  1,  0 },
+        {  0,  1 },
+        { -1,  0 }
+    } };
+    const Vector2<int> size = _grid.Size( );
+    const Vector2<int> center = size / 2;
+    DisjointSet regions( size.x * size.y );
+    std::vector<int> costs( size.x * size.y );
+    std::vector<int> parents( size.x * size.y );
+    std::deque<int> queue;
     Vector2<int> iterator;
-    auto Surrounded = [this] ( const Vector2<int>& position, int threshold ) -> bool
-    {
-        static constexpr std::array<Vector2<int>, 8> directions
-        { {
-            {  0, -1 },
-            {  1, -1 },
-            {  1,  0 },
-            {  1,  1 },
-            {  0,  1 },
-            { -1,  1 },
-            { -1,  0 },
-            { -1, -1 }
-        } };
-        int count = 0;
-
+    auto Index = [&size] ( const Vector2<int>& position )
+    {
+        return position.y * size.x + position.x;
+    };
+    auto Open = [this] ( const Vector2<int>& position )
+    {
+        return TileLacking( position, Attributes::Obstacle );
+    };
+    auto Carvable = [this, &size] ( const Vector2<int>& position )
+    {
+        return !OnBorder( position, size ) &&
+               _grid[position].terrain == Terrain::Wall &&
+               _grid[position].occupants.empty( );
+    };
+    auto Join = [&] ( const Vector2<int>& position )
+    {
         for( const auto& direction : directions )
         {
-            if( !( this->TileLacking( position + direction, Attributes::Obstacle ) ) )
+            const Vector2<int> neighbour = position + direction;
+
+            if( InBounds( neighbour, size ) &&
+                Open( neighbour ) )
             {
-                count++;
+                regions.Unite( Index( position ), Index( neighbour ) );
             }
         }
-
-        return count >= threshold;
+    };
+    auto Connected = [&] ( const Vector2<int>& position )
+    {
+        return Open( position ) &&
+               Open( center ) &&
+               regions.Find( Index( position ) ) == regions.Find( Index( center ) );
     };
 
-    for( int i = 0; i < limit; i++ )
+    if( !Open( center ) &&
+        !Carvable( center ) )
     {
-        for( iterator.y = 1; iterator.y < _grid.Size( ).y - 1; iterator.y++ )
+        return;
+    }
+
+    for( iterator.y = 0; iterator.y < size.y; iterator.y++ )
+    {
+        for( iterator.x = 0; iterator.x < size.x; iterator.x++ )
         {
-            for( iterator.x = 1; iterator.x < _grid.Size( ).x - 1; iterator.x++ )
+            if( Open( iterator ) )
             {
-                if( Unoccupied( iterator ) &&
-                    Surrounded( iterator, 5 ) )
+                Join( iterator );
+            }
+        }
+    }
+
+    for( const auto& door : GetDoors( ) )
+    {
+        const Vector2<int> start
+        {
+            std::clamp( door->position.x, 1, size.x - 2 ),
+            std::clamp( door->position.y, 1, size.y - 2 )
+        };
+        std::optional<int> reached;
+
+        if( Connected( start ) ||
+            !( Open( start ) || Carvable( start ) ) )
+        {
+            continue;
+        }
+
+        std::fill( costs.begin( ), costs.end( ), std::numeric_limits<int>::max( ) );
+        costs[Index( start )] = Open( start ) ? 0 : 1;
+        parents[Index( start )] = -1;
+        queue.assign( 1, Index( start ) );
+
+        while( !queue.empty( ) )
+        {
+            const int index = queue.front( );
+            const Vector2<int> position = { index % size.x, index / size.x };
+
+            queue.pop_front( );
+
+            if( position == center ||
+                Connected( position ) )
+            {
+                reached = index;
+
+                break;
+            }
+
+            for( const auto& direction : directions )
+            {
+                const Vector2<int> neighbour = position + direction;
+
+                if( !InBounds( neighbour, size ) )
                 {
-                    EntityInsert( iterator, entityFactory.Get( "Wall" )->Clone( ) );
+                    continue;
+                }
+
+                const bool open = Open( neighbour );
+                const int cost = costs[index] + ( open ? 0 : 1 );
+
+                if( ( open || Carvable( neighbour ) ) &&
+                    cost < costs[Index( neighbour )] )
+                {
+                    costs[Index( neighbour )] = cost;
+                    parents[Index( neighbour )] = index;
+                    open ? queue.push_front( Index( neighbour ) ) : queue.push_back( Index( neighbour ) );
                 }
             }
         }
+
+        for( int index = reached.value_or( -1 ); index != -1; index = parents[index] )
+        {
+            const Vector2<int> position = { index % size.x, index / size.x };
+
+            if( !Open( position ) )
+            {
+                TerrainInsert( position, Terrain::None );
+            }
+
+            Join( position );
+        }
     }
 }
-void Dungeon::GenerateEnemies( const EntityFactory& entityFactory, int amount )
+void Dungeon::GenerateRooms( )
 {
-    const std::vector<Entity*> enemies = entityFactory.Get( Attributes::Hostile | Attributes::Movement );
-    const int limit = amount ? amount : ( _grid.Size( ).x * _grid.Size( ).y ) / 150;
+    /*
+        Binary space partition of the interior, leaves hold one room each and every split
+        joins a room from either side with an L shaped corridor, so all rooms connect.
+        The map starts solid and only rooms and corridors are carved, one write per tile.
+    */
+    struct Node
+    {
+        Vector2<int> begin;
+        Vector2<int> end;
+        std::array<int, 2> children;
+        Vector2<int> anchor;
+    };
+    static constexpr int leafMin = 8;
+    static constexpr int roomMin = 3;
+    const Vector2<int> size = _grid.Size( );
+    std::vector<Node> nodes;
+    Vector2<int> iterator;
+    auto Carve = [this] ( const Vector2<int>& position )
+    {
+        if( _grid[position].terrain == Terrain::Wall )
+        {
+            TerrainInsert( position, Terrain::None );
+        }
+    };
+    auto Corridor = [this, &Carve] ( Vector2<int> from, const Vector2<int>& to )
+    {
+        const bool horizontalFirst = _rng.Get( 0, 1 ) == 0;
 
-    for( int i = 0; i < limit; i++ )
+        for( int leg = 0; leg < 2; leg++ )
+        {
+            int& axis = horizontalFirst == ( leg == 0 ) ? from.x : from.y;
+            const int target = horizontalFirst == ( leg == 0 ) ? to.x : to.y;
+
+            while( axis != target )
+            {
+                Carve( from );
+                axis += axis < target ? 1 : -1;
+            }
+        }
+
+        Carve( to );
+    };
+    auto Span = [this] ( int extent ) -> std::pair<int, int>
     {
-        while( true )
+        /* Rooms keep a one tile margin inside the leaf so neighbouring rooms never merge */
+        const int margin = extent > 2 ? 1 : 0;
+        const int length = _rng.Get( std::min( roomMin, extent - margin * 2 ), extent - margin * 2 );
+
+        return { margin + _rng.Get( 0, extent - margin * 2 - length ), length };
+    };
+    auto Leaf = [&nodes] ( const Vector2<int>& position )
+    {
+        int index = 0;
+
+        while( nodes[index].children[0] != -1 )
         {
-            const Vector2<int> position
+            const Node& child = nodes[nodes[index].children[0]];
+
+            index = position.x >= child.begin.x && position.x < child.end.x &&
+                    position.y >= child.begin.y && position.y < child.end.y ? nodes[index].children[0] : nodes[index].children[1];
+        }
+
+        return index;
+    };
+
+    for( iterator.y = 0; iterator.y < size.y; iterator.y++ )
+    {
+        for( iterator.x = 0; iterator.x < size.x; iterator.x++ )
+        {
+            if( Unoccupied( iterator ) )
             {
-                GetRNG( 1, _grid.Size( ).x - 2 ),
-                GetRNG( 1, _grid.Size( ).y - 2 )
-            };
+                TerrainInsert( iterator, Terrain::Wall );
+            }
+        }
+    }
 
-            if( Unoccupied( position ) )
+    if( size.x < 3 || size.y < 3 )
+    {
+        return;
+    }
+
+    /* Children are always pushed after their parent, so a reverse sweep visits them first */
+    nodes.push_back( { { 1, 1 }, size - Vector2<int>{ 1, 1 }, { -1, -1 }, { 0, 0 } } );
+
+    for( std::size_t i = 0; i < nodes.size( ); i++ )
+    {
+        const Vector2<int> extent = nodes[i].end - nodes[i].begin;
+        const bool vertical = extent.x > extent.y;
+        const int length = vertical ? extent.x : extent.y;
+
+        if( length >= leafMin * 2 )
+        {
+            const int cut = _rng.Get( leafMin, length - leafMin );
+            Node first = { nodes[i].begin, nodes[i].end, { -1, -1 }, { 0, 0 } };
+            Node second = first;
+
+            if( vertical )
+            {
+                first.end.x = second.begin.x = nodes[i].begin.x + cut;
+            }
+            else
             {
-                const int index = GetRNG( 0, enemies.size( ) - 1 );
+                first.end.y = second.begin.y = nodes[i].begin.y + cut;
+            }
+
+            nodes[i].children = { static_cast<int>( nodes.size( ) ), static_cast<int>( nodes.size( ) ) + 1 };
+            nodes.push_back( first );
+            nodes.push_back( second );
+        }
+    }
 
-                EntityInsert( position, enemies[index]->Clone( ) );
+    for( int i = nodes.size( ) - 1; i >= 0; i-- )
+    {
+        Node& node = nodes[i];
 
-                break;
+        if( node.children[0] == -1 )
+        {
+            const std::pair<int, int> spanX = Span( node.end.x - node.begin.x );
+            const std::pair<int, int> spanY = Span( node.end.y - node.begin.y );
+            const Vector2<int> corner = node.begin + Vector2<int>{ spanX.first, spanY.first };
+            const Vector2<int> room = { spanX.second, spanY.second };
+
+            for( iterator.y = corner.y; iterator.y < corner.y + room.y; iterator.y++ )
+            {
+                for( iterator.x = corner.x; iterator.x < corner.x + room.x; iterator.x++ )
+                {
+                    Carve( iterator );
+                }
             }
+
+            node.anchor =
+            {
+                _rng.Get( corner.x, corner.x + room.x - 1 ),
+                _rng.Get( corner.y, corner.y + room.y - 1 )
+            };
+        }
+        else
+        {
+            const Vector2<int> first = nodes[node.children[0]].anchor;
+            const Vector2<int> second = nodes[node.children[1]].anchor;
+
+            Corridor( first, second );
+            node.anchor = _rng.Get( 0, 1 ) ? first : second;
+        }
+    }
+
+    /* Doors and the player start are tied into the room of the leaf they sit in */
+    for( const auto& door : GetDoors( ) )
+    {
+        const Vector2<int> inside
+        {
+            std::clamp( door->position.x, 1, size.x - 2 ),
+            std::clamp( door->position.y, 1, size.y - 2 )
+        };
+
+        Corridor( inside, nodes[Leaf( inside )].anchor );
+    }
+
+    Corridor( size / 2, nodes[Leaf( size / 2 )].anchor );
+}
+void Dungeon::GenerateEnemies( int amount )
+{
+    /* Tiles pick spots and kinds in parallel, the entities are then inserted in tile order */
+    const std::vector<Entity*>& enemies = _entityFactory.Get( Attributes::Hostile | Attributes::Movement );
+    const int limit = amount ? amount : ( _grid.Size( ).x * _grid.Size( ).y ) / 150;
+    std::vector<PositionSampler> unoccupied( TileCount( ), PositionSampler( { 0, 0 } ) );
+    std::vector<int> capacities( TileCount( ) );
+    std::vector<std::vector<std::pair<Vector2<int>, int>>> placements( TileCount( ) );
+
+    TileParallel( [this, &unoccupied, &capacities] ( int tile, int rowBegin, int rowEnd )
+    {
+        unoccupied[tile] = UnoccupiedInterior( rowBegin, rowEnd );
+        capacities[tile] = unoccupied[tile].Size( );
+    } );
+
+    const std::vector<int> shares = Apportion( limit, capacities );
+
+    TileParallel( [this, &unoccupied, &shares, &placements, &enemies] ( int tile, int rowBegin, int )
+    {
+        RandomGenerator generator = _rng.Split( StreamEnemies | tile );
+
+        for( int i = 0; i < shares[tile]; i++ )
+        {
+            const Vector2<int> position = unoccupied[tile].Sample( generator );
+            const int index = generator.Get( 0, enemies.size( ) - 1 );
+
+            placements[tile].emplace_back( Vector2<int>{ position.x, position.y + rowBegin }, index );
+            unoccupied[tile].Erase( position );
+        }
+    } );
+
+    for( const auto& placement : placements )
+    {
+        for( const auto& [position, index] : placement )
+        {
+            EntityInsert( position, enemies[index]->Clone( _arena ) );
         }
     }
 }
\ No newline at end of file
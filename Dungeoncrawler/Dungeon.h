@@ -4,10 +4,16 @@
 #include "Grid.h"
 #include "Enums.h"
 #include "EntityFactory.h"
+#include "Arena.h"
+#include "EntityStore.h"
+#include "Random.h"
+#include "PositionSampler.h"
 #include <vector>
 #include <utility>
 #include <memory>
-#include <unordered_set>
+#include <functional>
+#include <array>
+#include <map>
 #include <vector>
 
 class BattleSystem;
@@ -32,6 +38,7 @@ struct DungeonConfiguration
         bool wallsChildren;
         bool wallsFiller;
         bool enemies;
+        bool connectivity;
     } generate;
 
     struct
@@ -42,19 +49,26 @@ struct DungeonConfiguration
         int wallsFillerCycles;
         int enemies;
     } amount;
+
+    struct
+    {
+        bool wallsFillerInPlace;
+        int threads;
+        Layout::Enum layout;
+    } options;
 };
 
 struct Tile
 {
     std::vector<Entity*> occupants = { };
-    char icon = '-';
+    Terrain::Enum terrain = Terrain::None;
 };
 
 class Dungeon
 {
     public:
-        Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const DungeonConfiguration& config );
-        Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const Grid<char>& icons, const std::vector<Door>& doors );
+        Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const DungeonConfiguration& config, std::uint64_t seed );
+        Dungeon( PlayerHandle& player, const EntityFactory& entityFactory, const Grid<char>& icons, const std::vector<Door>& doors, std::uint64_t seed );
         Dungeon( Dungeon&& dungeon ) = default;
 
         void PlayerSet( const std::optional<int>& index );
@@ -62,38 +76,60 @@ class Dungeon
         void Events( const BattleSystem& battleSystem );
         void Rotate( Orientation orientation );
         void MovementPlayer( Orientation orientation );
-        void MovementRandom( );
+        void Advance( );
 
         const Vector2<int>& GetSize( ) const;
+        const std::array<double, Stage::Count>& GetTimings( ) const;
         const std::vector<Door*> GetDoors( ) const;
         char GetIcon( const Vector2<int>& position ) const;
         bool Visible( const Vector2<int>& position ) const;
+        const char* GetIconRow( int y ) const;
+        const char* GetVisionRow( int y ) const;
         bool Unoccupied( const Vector2<int>& position ) const;
         bool TileLacking( const Vector2<int>& position, int bitmask ) const;
 
     private:
+        RandomGenerator _rng;
+        int _threads;
+        std::array<double, Stage::Count> _timings;
         Grid<Tile> _grid;
-        std::vector<int> _indexDoors;
-        std::vector<std::unique_ptr<Entity>> _entities;
-        std::unordered_set<Vector2<int>, HasherVector2<int>> _vision;
+        Grid<char> _icons;
+        Grid<char> _visionMask;
+        std::vector<EntityHandle> _indexDoors;
+        std::vector<EntityHandle> _dead;
+        std::int64_t _time;
+        std::map<std::int64_t, std::vector<EntityHandle>> _schedule;
+        std::vector<EntityHandle> _due;
+        Arena _arena;
+        EntityStore _entities;
+        std::vector<Vector2<int>> _vision;
         PlayerHandle& _player;
+        const EntityFactory& _entityFactory;
 
         void UpdateTile( const Vector2<int>& position );
         void BuildVision( const Vector2<int>& position, int visionReach );
+        void See( const Vector2<int>& position );
         void FixVisionNearbyWalls( const Vector2<int>& position, int visionReach );
         void FixVisionDeadspots( const Vector2<int>& position );
         void LineOfSight( const std::vector<Vector2<int>>& path, int visionReach, Vector2<int> start );
         void LineOfSight( const std::vector<Vector2<int>>& path );
         void OccupantInsert( const Vector2<int>& position, Entity* entity );
         void OccupantRemove( const Vector2<int>& position, Entity* entity );
-        void EntityInsert( const Vector2<int>& position, Entity* entity );
-        void EntityRemove( int index );
+        EntityHandle EntityInsert( const Vector2<int>& position, Entity* entity );
+        void EntityRemove( const std::vector<EntityHandle>& handles );
+        void TerrainInsert( const Vector2<int>& position, Terrain::Enum terrain );
+        PositionSampler UnoccupiedInterior( int rowBegin, int rowEnd ) const;
+        int TileCount( ) const;
+        void TileParallel( const std::function<void( int tile, int rowBegin, int rowEnd )>& body );
 
-        void GenerateDoors( const EntityFactory& entityFactory, int amount );
-        void GenerateWallsOuter( const EntityFactory& entityFactory );
-        void GenerateHiddenPath( const EntityFactory& entityFactory );
-        void GenerateWallsParents( const EntityFactory& entityFactory, int amount );
-        void GenerateWallsChildren( const EntityFactory& entityFactory, int amount );
-        void GenerateWallsFiller( const EntityFactory& entityFactory, int amount );
-        void GenerateEnemies( const EntityFactory& entityFactory, int amount );
+        void Timed( Stage::Enum stage, const std::function<void( )>& function );
+        void GenerateDoors( int amount );
+        void GenerateWallsOuter( );
+        void GenerateHiddenPath( );
+        void GenerateWallsParents( int amount );
+        void GenerateWallsChildren( int amount );
+        void GenerateWallsFiller( int amount, bool inPlace );
+        void GenerateConnectivity( );
+        void GenerateRooms( );
+        void GenerateEnemies( int amount );
 };
\ No newline at end of file
@@ -1,10 +1,45 @@
 #include "EntityFactory.h"
 #include "Functions.h"
+#include <unordered_set>
+#include <functional>
+#include <mutex>
 
-Entity::Entity( const std::string& name, char icon, int attributes ) :
-    name( name ),
-    icon( icon ),
-    attributes( attributes ),
+namespace
+{
+    struct EntityTypeHash
+    {
+        std::size_t operator()( const EntityType& type ) const
+        {
+            std::size_t hash = std::hash<std::string>( )( type.name );
+
+            for( const int value : { static_cast<int>( type.icon ), type.attributes, type.damage, type.spells } )
+            {
+                hash ^= std::hash<int>( )( value ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+            }
+
+            return hash;
+        }
+    };
+    struct EntityTypeEqual
+    {
+        bool operator()( const EntityType& a, const EntityType& b ) const
+        {
+            return
+                a.name == b.name &&
+                a.icon == b.icon &&
+                a.attributes == b.attributes &&
+                a.damage == b.damage &&
+                a.spells == b.spells;
+        }
+    };
+}
+
+Entity::Entity( const std::string& name, char icon, int attributes, int kind ) :
+    Entity( EntityFactory::Intern( { name, icon, attributes, 0, 0 } ), kind )
+{ }
+Entity::Entity( const EntityType& type, int kind ) :
+    type( type ),
+    kind( kind ),
     active( true ),
     position( { -1, -1 } )
 { }
@@ -12,48 +47,47 @@ Entity::~Entity( )
 {
 
 }
-Entity* Entity::Clone( ) const
+Entity* Entity::Clone( Arena& arena ) const
 {
-    return new Entity( *this );
+    return arena.Create<Entity>( *this );
 }
-void Entity::Interact( Player& player )
+void Entity::Interact( Player& player ) const
 {
 
 }
 
 Door::Door( const std::string& name, char icon, int attributes ) :
-    Entity( name, icon, attributes )
+    Entity( name, icon, attributes, kinds )
 { }
-Door* Door::Clone( ) const
+Door* Door::Clone( Arena& arena ) const
 {
-    return new Door( *this );
+    return arena.Create<Door>( *this );
 }
-void Door::Interact( Player& player )
+void Door::Interact( Player& player ) const
 {
     player.next = connector;
 }
 
 Wall::Wall( const std::string& name, char icon, int attributes ) :
-    Entity( name, icon, attributes )
+    Entity( name, icon, attributes, kinds )
 { }
-Wall* Wall::Clone( ) const
+Wall* Wall::Clone( Arena& arena ) const
 {
-    return new Wall( *this );
+    return arena.Create<Wall>( *this );
 }
-void Wall::Interact( Player& player )
+void Wall::Interact( Player& player ) const
 {
     player.blocked = true;
 }
 
-Character::Character( const std::string& name, char icon, int attributes, Health health, int damage, int spells ) :
-    Entity( name, icon, attributes ),
+Character::Character( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int speed, int kind ) :
+    Entity( EntityFactory::Intern( { name, icon, attributes, damage, spells } ), kind ),
     health( health ),
-    damage( damage ),
-    spells( spells )
+    speed( speed )
 { }
-Character* Character::Clone( ) const
+Character* Character::Clone( Arena& arena ) const
 {
-    return new Character( *this );
+    return arena.Create<Character>( *this );
 }
 void Character::Update( )
 {
@@ -72,20 +106,20 @@ void Character::Update( )
     }
 }
 
-Player::Player( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int visionReach ) :
-    Character( name, icon, attributes, health, damage, spells ),
+Player::Player( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int speed, int visionReach ) :
+    Character( name, icon, attributes, health, damage, spells, speed, kinds ),
     visionReach( visionReach ),
     blocked( false )
 { }
 
 PlayerHandle::PlayerHandle( const Player& player ) :
     base( std::make_unique<Player>( player ) ),
-    real( dynamic_cast<Player*>( base.get( ) ) )
+    real( EntityCast<Player>( base.get( ) ) )
 { }
 void PlayerHandle::Reset( const Player& player )
 {
     base.reset( new Player( player ) );
-    real = dynamic_cast<Player*>( base.get( ) );
+    real = EntityCast<Player>( base.get( ) );
 }
 
 EntityFactory::EntityFactory( ) :
@@ -95,7 +129,7 @@ EntityFactory::EntityFactory( ) :
 
         for( const auto& character : characters )
         {
-            temp.insert_or_assign( character.name, std::make_unique<Character>( character ) );
+            temp.insert_or_assign( character.type.name, std::make_unique<Character>( character ) );
         }
 
         temp.insert_or_assign( "Hidden", std::make_unique<Entity>( "Hidden", '-', 0 ) );
@@ -104,7 +138,41 @@ EntityFactory::EntityFactory( ) :
         temp.insert_or_assign( "PlayerDefault", std::make_unique<Player>( player ) );
 
         return std::move( temp );
-    } ( LoadCharacters( ), LoadPlayerDefault( ) ) )
+    } ( LoadCharacters( ), LoadPlayerDefault( ) ) ),
+    _terrain( { nullptr, _entities.at( "Hidden" ).get( ), _entities.at( "Wall" ).get( ) } ),
+    _icons( [this] ( )
+    {
+        std::array<const std::unique_ptr<Entity>*, 256> temp { };
+
+        for( const auto& it : _entities )
+        {
+            const unsigned char index = it.second->type.icon;
+
+            if( !temp[index] )
+            {
+                temp[index] = &it.second;
+            }
+        }
+
+        return temp;
+    } ( ) ),
+    _masks( [this] ( )
+    {
+        std::array<std::vector<Entity*>, _masksSize> temp;
+
+        for( int bitmask = 0; bitmask < _masksSize; bitmask++ )
+        {
+            for( const auto& it : _entities )
+            {
+                if( it.second->type.attributes & bitmask )
+                {
+                    temp[bitmask].push_back( it.second.get( ) );
+                }
+            }
+        }
+
+        return temp;
+    } ( ) )
 { }
 
 const std::unique_ptr<Entity>& EntityFactory::Get( const std::string& name ) const
@@ -113,31 +181,46 @@ const std::unique_ptr<Entity>& EntityFactory::Get( const std::string& name ) con
 }
 const std::unique_ptr<Entity>& EntityFactory::Get( char icon ) const
 {
-    for( const auto& it : _entities )
+    const unsigned char index = icon;
+
+    if( !_icons[index] )
     {
-        if( it.second->icon == icon )
-        {
-            return it.second;
-        }
+        throw std::exception( "Entity does not exist!" );
     }
 
-    throw std::exception( "Entity does not exist!" );
+    return *_icons[index];
 }
-const std::vector<Entity*> EntityFactory::Get( int bitmask ) const
+const std::vector<Entity*>& EntityFactory::Get( int bitmask ) const
 {
-    std::vector<Entity*> matching;
-
-    for( const auto& it : _entities )
+    return _masks.at( bitmask );
+}
+const Entity* EntityFactory::Get( Terrain::Enum terrain ) const
+{
+    return _terrain[terrain];
+}
+Terrain::Enum EntityFactory::GetTerrain( char icon ) const
+{
+    for( int i = Terrain::Hidden, limit = _terrain.size( ); i < limit; i++ )
     {
-        if( it.second->attributes & bitmask )
+        if( _terrain[i]->type.icon == icon )
         {
-            matching.push_back( it.second.get( ) );
+            return static_cast<Terrain::Enum>( i );
         }
     }
 
-    return matching;
+    return Terrain::None;
 }
 const Player EntityFactory::PlayerDefault( ) const
 {
-    return *dynamic_cast<Player*>( Get( "PlayerDefault" ).get( ) );
+    return *EntityCast<Player>( Get( "PlayerDefault" ).get( ) );
+}
+
+const EntityType& EntityFactory::Intern( const EntityType& type )
+{
+    /* Immutable per-type data is stored once, instances only reference it. Set nodes never move, so references stay valid */
+    static std::mutex mutex;
+    static std::unordered_set<EntityType, EntityTypeHash, EntityTypeEqual> types;
+    const std::lock_guard<std::mutex> lock( mutex );
+
+    return *types.insert( type ).first;
 }
\ No newline at end of file
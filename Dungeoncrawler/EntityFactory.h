@@ -3,8 +3,10 @@
 #include "Vector2.h"
 #include "Enums.h"
 #include "BattleSystem.h"
+#include "Arena.h"
 #include <string>
 #include <memory>
+#include <array>
 #include <map>
 
 struct Player;
@@ -22,61 +24,89 @@ struct Health
     int regeneration;
 };
 
+struct EntityType
+{
+    std::string name;
+    char icon;
+    int attributes;
+    int damage;
+    int spells;
+};
+
 struct Entity
 {
-    Entity( const std::string& name, char icon, int attributes );
+    static constexpr int kinds = Kind::Entity;
+
+    Entity( const std::string& name, char icon, int attributes, int kind = kinds );
+    Entity( const EntityType& type, int kind );
     virtual ~Entity( );
 
-    virtual Entity* Clone( ) const;
-    virtual void Interact( Player& player );
+    virtual Entity* Clone( Arena& arena ) const;
+    virtual void Interact( Player& player ) const;
 
-    const std::string name;
-    const char icon;
-    const int attributes;
+    const EntityType& type;
+    const int kind;
     bool active;
     Vector2<int> position;
 };
 
 struct Door : public Entity
 {
+    static constexpr int kinds = Entity::kinds | Kind::Door;
+
     Door( const std::string& name, char icon, int attributes );
 
-    Door* Clone( ) const override;
-    void Interact( Player& player ) override;
+    Door* Clone( Arena& arena ) const override;
+    void Interact( Player& player ) const override;
 
     std::optional<Connector> connector;
 };
 
 struct Wall : public Entity
 {
+    static constexpr int kinds = Entity::kinds | Kind::Wall;
+
     Wall( const std::string& name, char icon, int attributes );
 
-    Wall* Clone( ) const override;
-    void Interact( Player& player ) override;
+    Wall* Clone( Arena& arena ) const override;
+    void Interact( Player& player ) const override;
 };
 
 struct Character : public Entity
 {
-    Character( const std::string& name, char icon, int attributes, Health health, int damage, int spells );
+    static constexpr int kinds = Entity::kinds | Kind::Character;
+
+    Character( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int speed, int kind = kinds );
 
-    Character* Clone( ) const override;
+    Character* Clone( Arena& arena ) const override;
     void Update( );
 
     Health health;
-    int damage;
-    int spells;
+    int speed;
     std::map<std::string, Effect> effects;
 };
 
 struct Player : public Character
 {
-    Player( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int visionReach );
+    static constexpr int kinds = Character::kinds | Kind::Player;
+
+    Player( const std::string& name, char icon, int attributes, Health health, int damage, int spells, int speed, int visionReach );
 
     int visionReach;
     bool blocked;
     std::optional<Connector> next;
 };
 
+template<class T> T* EntityCast( Entity* entity )
+{
+    /* Checked downcast, the kind tag replaces a dynamic_cast with a single mask test */
+    return entity && ( entity->kind & T::kinds ) == T::kinds ? static_cast<T*>( entity ) : nullptr;
+}
+template<class T> const T* EntityCast( const Entity* entity )
+{
+    return entity && ( entity->kind & T::kinds ) == T::kinds ? static_cast<const T*>( entity ) : nullptr;
+}
+
 struct PlayerHandle
 {
     PlayerHandle( const Player& player );
@@ -94,9 +124,19 @@ class EntityFactory
 
         const std::unique_ptr<Entity>& Get( const std::string& name ) const;
         const std::unique_ptr<Entity>& Get( char icon ) const;
-        const std::vector<Entity*> Get( int bitmask ) const;
+        const std::vector<Entity*>& Get( int bitmask ) const;
+        const Entity* Get( Terrain::Enum terrain ) const;
+        Terrain::Enum GetTerrain( char icon ) const;
         const Player PlayerDefault( ) const;
 
+        static const EntityType& Intern( const EntityType& type );
+
     private:
+        /* Every combination of attribute bits has a list */
+        static constexpr int _masksSize = ( Attributes::End - 1 ) << 1;
+
         const std::map<std::string, std::unique_ptr<Entity>> _entities;
+        const std::array<const Entity*, 3> _terrain;
+        const std::array<const std::unique_ptr<Entity>*, 256> _icons;
+        const std::array<std::vector<Entity*>, _masksSize> _masks;
 };
\ No newline at end of file
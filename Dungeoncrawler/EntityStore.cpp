@@ -0,0 +1,125 @@
+#include "EntityStore.h"
+#include <utility>
+
+EntityHandle EntityStore::Insert( Entity* entity, const Vector2<int>& position )
+{
+    int slot;
+
+    if( _free.empty( ) )
+    {
+        slot = _indices.size( );
+        _indices.push_back( 0 );
+        _generations.push_back( 0 );
+    }
+    else
+    {
+        slot = _free.back( );
+        _free.pop_back( );
+    }
+
+    entity->position = position;
+    _indices[slot] = _entities.size( );
+    _slots.push_back( slot );
+    _entities.push_back( entity );
+    _positions.push_back( position );
+    _active.push_back( entity->active );
+    _lookup[entity] = slot;
+
+    return { slot, _generations[slot] };
+}
+void EntityStore::Remove( const std::vector<EntityHandle>& handles )
+{
+    /* Compact all columns in one stable pass, surviving entities keep their relative order */
+    std::vector<char> removing( _entities.size( ), false );
+    int next = 0;
+
+    for( const auto& handle : handles )
+    {
+        if( Valid( handle ) )
+        {
+            removing[_indices[handle.slot]] = true;
+            _lookup.erase( _entities[_indices[handle.slot]] );
+            _generations[handle.slot]++;
+            _free.push_back( handle.slot );
+        }
+    }
+
+    for( int i = 0, limit = _entities.size( ); i < limit; i++ )
+    {
+        if( !removing[i] )
+        {
+            if( next != i )
+            {
+                _entities[next]  = _entities[i];
+                _positions[next] = _positions[i];
+                _active[next]    = _active[i];
+                _slots[next]     = _slots[i];
+                _indices[_slots[next]] = next;
+            }
+
+            next++;
+        }
+    }
+
+    _entities.resize( next );
+    _positions.resize( next );
+    _active.resize( next );
+    _slots.resize( next );
+}
+void EntityStore::Move( int index, const Vector2<int>& position )
+{
+    _positions[index] = position;
+    _entities[index]->position = position;
+}
+void EntityStore::Pull( int index )
+{
+    _positions[index] = _entities[index]->position;
+    _active[index] = _entities[index]->active;
+}
+
+int EntityStore::Size( ) const
+{
+    return _entities.size( );
+}
+bool EntityStore::Valid( const EntityHandle& handle ) const
+{
+    return
+        handle.slot >= 0 &&
+        handle.slot < static_cast<int>( _generations.size( ) ) &&
+        _generations[handle.slot] == handle.generation;
+}
+int EntityStore::Index( const EntityHandle& handle ) const
+{
+    return _indices[handle.slot];
+}
+EntityHandle EntityStore::Handle( int index ) const
+{
+    return { _slots[index], _generations[_slots[index]] };
+}
+std::optional<int> EntityStore::Find( const Entity* entity ) const
+{
+    const auto it = _lookup.find( entity );
+
+    if( it == _lookup.end( ) )
+    {
+        return std::nullopt;
+    }
+
+    return _indices[it->second];
+}
+Entity* EntityStore::Get( const EntityHandle& handle ) const
+{
+    return _entities[_indices[handle.slot]];
+}
+const std::vector<Entity*>& EntityStore::Entities( ) const
+{
+    return _entities;
+}
+const std::vector<Vector2<int>>& EntityStore::Positions( ) const
+{
+    return _positions;
+}
+const std::vector<char>& EntityStore::Active( ) const
+{
+    return _active;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Vector2.h"
+#include "EntityFactory.h"
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+struct EntityHandle
+{
+    int slot;
+    int generation;
+};
+
+inline bool operator==( const EntityHandle& lhs, const EntityHandle& rhs )
+{
+    return lhs.slot == rhs.slot && lhs.generation == rhs.generation;
+}
+
+class EntityStore
+{
+    /*
+        Dense columns of the hot per-turn state of every entity inside a dungeon.
+        The Entity objects keep their own fields as a view for cold code paths,
+        the store writes through to them whenever it changes a position.
+
+        Handles carry the generation of their slot, a slot is reused only after
+        its generation has been bumped so stale handles never alias a new entity.
+        Entities are looked up by address through their slot, never by scanning.
+    */
+
+    public:
+        EntityHandle Insert( Entity* entity, const Vector2<int>& position );
+        void Remove( const std::vector<EntityHandle>& handles );
+        void Move( int index, const Vector2<int>& position );
+        void Pull( int index );
+
+        int Size( ) const;
+        bool Valid( const EntityHandle& handle ) const;
+        int Index( const EntityHandle& handle ) const;
+        EntityHandle Handle( int index ) const;
+        std::optional<int> Find( const Entity* entity ) const;
+        Entity* Get( const EntityHandle& handle ) const;
+        const std::vector<Entity*>& Entities( ) const;
+        const std::vector<Vector2<int>>& Positions( ) const;
+        const std::vector<char>& Active( ) const;
+
+    private:
+        std::vector<Entity*> _entities;
+        std::vector<Vector2<int>> _positions;
+        std::vector<char> _active;
+        std::vector<int> _slots;
+        std::vector<int> _indices;
+        std::vector<int> _generations;
+        std::vector<int> _free;
+        std::unordered_map<const Entity*, int> _lookup;
+};
\ No newline at end of file
@@ -6,7 +6,58 @@ struct Attributes
     {
         Obstacle    = 1 << 0,
         Movement    = 1 << 1,
-        Hostile     = 1 << 2
+        Hostile     = 1 << 2,
+
+        /* One past the highest bit, new bits go above it */
+        End
+    };
+};
+
+struct Kind
+{
+    enum Enum
+    {
+        Entity      = 1 << 0,
+        Door        = 1 << 1,
+        Wall        = 1 << 2,
+        Character   = 1 << 3,
+        Player      = 1 << 4
+    };
+};
+
+struct Terrain
+{
+    enum Enum : unsigned char
+    {
+        None,
+        Hidden,
+        Wall
+    };
+};
+
+struct Layout
+{
+    enum Enum
+    {
+        Caves,
+        Rooms
+    };
+};
+
+struct Stage
+{
+    enum Enum
+    {
+        Doors,
+        WallsOuter,
+        HiddenPath,
+        WallsParents,
+        WallsChildren,
+        WallsFiller,
+        Connectivity,
+        Rooms,
+        Enemies,
+        Count
     };
 };
 
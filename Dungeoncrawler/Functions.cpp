@@ -1,6 +1,8 @@
 #include "Functions.h"
 #include "BattleSystem.h"
 #include "Game.h"
+#include "InputSource.h"
+#include "Renderer.h"
 #include "Enums.h"
 #include <iostream>
 #include <random>
@@ -16,13 +18,24 @@
 #include <string_view>
 #include <functional>
 
-int GetRNG( int min, int max )
+namespace
 {
-    static std::random_device rd;
-    static std::mt19937 generator( rd( ) );
-    std::uniform_int_distribution<int> random( min, max );
+    RandomGenerator& GetGenerator( )
+    {
+        thread_local RandomGenerator generator( SeedRandom( ) );
+
+        return generator;
+    }
+}
 
-    return random( generator );
+int GetRNG( int min, int max )
+{
+    return GetGenerator( ).Get( min, max );
+}
+void SeedRNG( std::uint64_t seed )
+{
+    /* Restarts the calling thread's stream so recorded sessions roll the same dice */
+    GetGenerator( ) = RandomGenerator( seed );
 }
 int GetPowerDiceRoll( const Power& power )
 {
@@ -124,38 +137,6 @@ std::string GetStringEffects( const std::vector<std::reference_wrapper<const Eff
 
     return output;
 }
-std::string GetStringDungeon( const Dungeon& dungeon, const Vector2<int>& center, const Vector2<int>& sizeScreen )
-{
-    const Vector2<int> origoCamera   = center - sizeScreen / 2;
-    const Vector2<int> iteratorBegin = origoCamera - 1;
-    const Vector2<int> iteratorEnd   = origoCamera + 2 + sizeScreen;
-    Vector2<int> iterator;
-    std::string output;
-
-    for( iterator.y = iteratorBegin.y; iterator.y < iteratorEnd.y; iterator.y++ )
-    {
-        for( iterator.x = iteratorBegin.x; iterator.x < iteratorEnd.x; iterator.x++ )
-        {
-            if( OnBorder( iterator, iteratorEnd, iteratorBegin ) )
-            {
-                output += '/';
-            }
-            else if( InBounds( iterator, dungeon.GetSize( ) ) &&
-                     dungeon.Visible( iterator ) )
-            {
-                output += dungeon.GetIcon( iterator );
-            }
-            else
-            {
-                output += ' ';
-            }
-        }
-
-        output += '\n';
-    }
-
-    return output;
-}
 Vector2<int> PositionRotate( const Vector2<int>& position, const Vector2<int>& size, Orientation rotation )
 {
     const std::map<Orientation, Vector2<int>> result
@@ -180,9 +161,9 @@ Vector2<int> PositionMove( const Vector2<int>& position, Orientation orientation
 
     return position + directions.at( orientation );
 }
-Vector2<int> PositionMoveProbability( const Vector2<int>& position, int north, int west, int south, int east, int still )
+Vector2<int> PositionMoveProbability( RandomGenerator& generator, const Vector2<int>& position, int north, int west, int south, int east, int still )
 {
-    const int random = GetRNG( 0, north + east + south + west + still - 1 );
+    const int random = generator.Get( 0, north + east + south + west + still - 1 );
 
     if( random < north )
     {
@@ -342,96 +323,112 @@ int RectQuadrantArithmetic( Orientation orientation )
 
     return quadrants.at( orientation );
 }
-DungeonConfiguration SelectDungeonConfiguration( )
+DungeonConfiguration SelectDungeonConfiguration( InputSource& input, Renderer& renderer )
 {
     DungeonConfiguration config;
-    auto Select = [] ( )
+    auto Select = [&input] ( )
     {
-        return 'Y' == SelectChar( { 'Y', 'N' }, std::toupper );
+        return 'Y' == SelectChar( input, { 'Y', 'N' }, std::toupper );
     };
 
-    std::cout << "\nFixed dungeon size, [Y/N]: ";
+    renderer.Print( "\nFixed dungeon size, [Y/N]: " );
     config.size.determined = Select( );
-    std::cout << "Generate doors, [Y/N]: ";
+    renderer.Print( "Generate doors, [Y/N]: " );
     config.generate.doors = Select( );
-    std::cout << "Generate outer walls, [Y/N]: ";
-    config.generate.wallsOuter = Select( );
-    std::cout << "Generate hidden path, [Y/N]: ";
-    config.generate.hiddenPath = Select( );
-    std::cout << "Generate parent walls, [Y/N]: ";
-    config.generate.wallsParents = Select( );
-    std::cout << "Generate children walls, [Y/N]: ";
-    config.generate.wallsChildren = Select( );
-    std::cout << "Generate filler walls, [Y/N]: ";
-    config.generate.wallsFiller = Select( );
-    std::cout << "Generate monsters, [Y/N]: ";
+    renderer.Print( "Generate rooms and corridors, [Y/N]: " );
+    config.options.layout = Select( ) ? Layout::Rooms : Layout::Caves;
+
+    if( config.options.layout == Layout::Caves )
+    {
+        renderer.Print( "Generate outer walls, [Y/N]: " );
+        config.generate.wallsOuter = Select( );
+        renderer.Print( "Generate hidden path, [Y/N]: " );
+        config.generate.hiddenPath = Select( );
+        renderer.Print( "Generate parent walls, [Y/N]: " );
+        config.generate.wallsParents = Select( );
+        renderer.Print( "Generate children walls, [Y/N]: " );
+        config.generate.wallsChildren = Select( );
+        renderer.Print( "Generate filler walls, [Y/N]: " );
+        config.generate.wallsFiller = Select( );
+        renderer.Print( "Connect regions to the doors, [Y/N]: " );
+        config.generate.connectivity = Select( );
+    }
+    else
+    {
+        /* Rooms carve their own walls and are connected by construction */
+        config.generate.wallsOuter    = false;
+        config.generate.hiddenPath    = false;
+        config.generate.wallsParents  = false;
+        config.generate.wallsChildren = false;
+        config.generate.wallsFiller   = false;
+        config.generate.connectivity  = false;
+    }
+
+    renderer.Print( "Generate monsters, [Y/N]: " );
     config.generate.enemies = Select( );
-    std::cout << "\n";
+    renderer.Print( "\n" );
 
     if( config.size.determined )
     {
-        std::cout << "Enter dungeon width: ";
-        config.size.dungeon.x = SelectPositiveInteger( );
-        std::cout << "Enter dungeon height: ";
-        config.size.dungeon.y = SelectPositiveInteger( );
+        renderer.Print( "Enter dungeon width: " );
+        config.size.dungeon.x = SelectPositiveInteger( input );
+        renderer.Print( "Enter dungeon height: " );
+        config.size.dungeon.y = SelectPositiveInteger( input );
     }
 
     if( config.generate.doors )
     {
-        std::cout << "Enter amount of doors: ";
-        config.amount.doors = SelectPositiveInteger( );
+        renderer.Print( "Enter amount of doors: " );
+        config.amount.doors = SelectPositiveInteger( input );
     }
     
     if( config.generate.wallsParents )
     {
-        std::cout << "Enter amount of parent walls: ";
-        config.amount.wallsParents = SelectPositiveInteger( );
+        renderer.Print( "Enter amount of parent walls: " );
+        config.amount.wallsParents = SelectPositiveInteger( input );
     }
 
     if( config.generate.wallsChildren )
     {
-        std::cout << "Enter amount of children walls: ";
-        config.amount.wallsChildren = SelectPositiveInteger( );
+        renderer.Print( "Enter amount of children walls: " );
+        config.amount.wallsChildren = SelectPositiveInteger( input );
     }
 
     if( config.generate.wallsFiller )
     {
-        std::cout << "Enter amount of filler wall cycles: ";
-        config.amount.wallsFillerCycles = SelectPositiveInteger( );
+        renderer.Print( "Enter amount of filler wall cycles: " );
+        config.amount.wallsFillerCycles = SelectPositiveInteger( input );
+        renderer.Print( "Grow filler walls in place, [Y/N]: " );
+        config.options.wallsFillerInPlace = 'Y' == SelectChar( input, { 'Y', 'N' }, std::toupper );
     }
 
     if( config.generate.enemies )
     {
-        std::cout << "Enter amount of enemies: ";
-        config.amount.enemies = SelectPositiveInteger( );
+        renderer.Print( "Enter amount of enemies: " );
+        config.amount.enemies = SelectPositiveInteger( input );
     }
 
     return config;
 }
-int SelectPositiveInteger( )
+int SelectPositiveInteger( InputSource& input )
 {
     while( true )
     {
-        std::string input;
+        const std::string token = input.Token( );
 
-        std::cin >> input;
-
-        if( input.size( ) < 10 &&
-            std::all_of( input.begin( ), input.end( ), ::isdigit ) )
+        if( token.size( ) < 10 &&
+            std::all_of( token.begin( ), token.end( ), ::isdigit ) )
         {
-            return std::stoi( input );
+            return std::stoi( token );
         }
     }
 }
-char SelectChar( const std::vector<char>& valid, std::function<int( int )> modifier )
+char SelectChar( InputSource& input, const std::vector<char>& valid, std::function<int( int )> modifier )
 {
     while( true )
     {
-        std::string input;
-        char last;
-
-        std::cin >> input;
-        last = modifier != nullptr ? modifier( input.back( ) ) : input.back( );
+        const char key = input.Key( );
+        const char last = modifier != nullptr ? modifier( key ) : key;
 
         if( std::find( valid.begin( ), valid.end( ), last ) != valid.end( ) )
         {
@@ -439,28 +436,16 @@ char SelectChar( const std::vector<char>& valid, std::function<int( int )> modif
         }
     }
 }
-void SelectEnter( )
+void SelectEnter( InputSource& input )
 {
-    std::cin.ignore( std::numeric_limits<std::streamsize>::max( ), '\n' );
-    std::cin.get( );
-}
-void ClearScreen( bool clear )
-{
-    if( clear )
-    {
-        #ifdef _WIN32
-        std::system("CLS");
-        #else
-        std::system("clear");
-        #endif
-    }
+    input.Enter( );
 }
 std::vector<Character> LoadCharacters( )
 {
     /*
     const std::string name = "Dungeoncrawler_Dependency_Characters.txt";
     const std::vector<std::string> fileCache { std::istream_iterator<StringWrapper> { std::ifstream { name, std::ios::in } }, { } };
-    constexpr int offset = 8;
+    constexpr int offset = 9;
     std::vector<Character> characters;
 
     if( fileCache.empty( ) )
@@ -481,7 +466,8 @@ std::vector<Character> LoadCharacters( )
                 std::stoi( fileCache[i + 5] )
             },
             std::stoi( fileCache[i + 6] ),
-            GetBitmask( fileCache[i + 7] )
+            GetBitmask( fileCache[i + 7] ),
+            std::stoi( fileCache[i + 8] )
         } );
     }
 
@@ -490,9 +476,9 @@ std::vector<Character> LoadCharacters( )
 
     return
     {
-        Character( "Zombie",   'Z', GetBitmask( "1,2" ), { 120, 120, 5 }, 20, GetBitmask( "" )  ),
-        Character( "Skeleton", 'S', GetBitmask( "1,2" ), { 80, 80, 0 },   10, GetBitmask( "1" ) ),
-        Character( "Lunatic",  'L', GetBitmask( "1,2" ), { 70, 70, 0 },   10, GetBitmask( "" )  )
+        Character( "Zombie",   'Z', GetBitmask( "1,2" ), { 120, 120, 5 }, 20, GetBitmask( "" ),  50  ),
+        Character( "Skeleton", 'S', GetBitmask( "1,2" ), { 80, 80, 0 },   10, GetBitmask( "1" ), 100 ),
+        Character( "Lunatic",  'L', GetBitmask( "1,2" ), { 70, 70, 0 },   10, GetBitmask( "" ),  150 )
     };
 }
 std::vector<Effect> LoadEffects( )
@@ -586,7 +572,8 @@ Player LoadPlayerDefault( )
             },
             std::stoi( fileCache[6] ),
             GetBitmask( fileCache[7] ),
-            std::stoi( fileCache[8] )
+            std::stoi( fileCache[8] ),
+            std::stoi( fileCache[9] )
         };
     */
 
@@ -598,6 +585,7 @@ Player LoadPlayerDefault( )
         { 100, 100, 1 },
         50,
         GetBitmask( "0,1,2,3,4" ),
+        100,
         8
     };
 }
\ No newline at end of file
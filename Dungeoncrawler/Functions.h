@@ -2,12 +2,15 @@
 
 #include "Vector2.h"
 #include "Enums.h"
+#include "Random.h"
 #include <vector>
 #include <string>
 #include <optional>
 #include <string_view>
 
 class Dungeon;
+class InputSource;
+class Renderer;
 struct Power;
 struct DungeonConfiguration;
 struct Effect;
@@ -46,16 +49,16 @@ class StringWrapper
 */
 
 int GetRNG( int min, int max );
+void SeedRNG( std::uint64_t seed );
 int GetPowerDiceRoll( const Power& power );
 int GetBitmask( const std::string& line );
 std::optional<Power> GetOptionalPower( const std::string& line );
 std::string GetStringPower( const Power& power );
 std::string GetStringHealth( const Health& health );
 std::string GetStringEffects( const std::vector<std::reference_wrapper<const Effect>>& effects );
-std::string GetStringDungeon( const Dungeon& dungeon, const Vector2<int>& center, const Vector2<int>& sizeScreen );
 Vector2<int> PositionRotate( const Vector2<int>& position, const Vector2<int>& size, Orientation rotation );
 Vector2<int> PositionMove( const Vector2<int>& position, Orientation orientation );
-Vector2<int> PositionMoveProbability( const Vector2<int>& position, int north, int west, int south, int east, int still );
+Vector2<int> PositionMoveProbability( RandomGenerator& generator, const Vector2<int>& position, int north, int west, int south, int east, int still );
 std::vector<Vector2<int>> BresenhamCircle( const Vector2<int>& center, int radius );
 std::vector<Vector2<int>> BresenhamLine( const Vector2<int>& start, const Vector2<int>& end );
 bool OnBorder( const Vector2<int>& position, const Vector2<int>& size, const Vector2<int>& origo = { 0, 0 }, int minLayer = 0, int maxLayer = 0 );
@@ -64,11 +67,10 @@ bool InBounds( const Vector2<int>& position, const Vector2<int>& size );
 Orientation RectQuadrant( const Vector2<int>& position, const Vector2<int>& size );
 Orientation RectQuadrantArithmetic( int orientation );
 int RectQuadrantArithmetic( Orientation orientation );
-DungeonConfiguration SelectDungeonConfiguration( );
-int SelectPositiveInteger( );
-char SelectChar( const std::vector<char>& valid, std::function<int( int )> modifier = nullptr );
-void SelectEnter( );
-void ClearScreen( bool clear );
+DungeonConfiguration SelectDungeonConfiguration( InputSource& input, Renderer& renderer );
+int SelectPositiveInteger( InputSource& input );
+char SelectChar( InputSource& input, const std::vector<char>& valid, std::function<int( int )> modifier = nullptr );
+void SelectEnter( InputSource& input );
 std::vector<Character> LoadCharacters( );
 std::vector<Effect> LoadEffects( );
 std::vector<Spell> LoadSpells( );
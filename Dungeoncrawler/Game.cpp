@@ -12,21 +12,41 @@
 #include <vector>
 #include <map>
 #include <deque>
+#include <algorithm>
+#include <thread>
 
-Game::Game( bool clear, bool save, bool exit, bool config ) :
-    _clearOutput( clear ),
+DungeonSlot::DungeonSlot( std::uint64_t seed, const std::optional<Connector>& entrance ) :
+    seed( seed ),
+    entrance( entrance )
+{ }
+
+Game::Game( InputSource& input, const std::string& saveName, std::uint64_t seed, bool clear, bool save, bool exit, bool config, bool headless ) :
     _saveToFile( save ),
     _exitable( exit ),
     _customConfig( config ),
-    _battleSystem( clear ),
+    _saveName( saveName ),
+    _input( input ),
+    _renderer( clear, headless ),
+    _viewport( { 32, 16 } ),
+    _battleSystem( _renderer, _input ),
     _player( _entityFactory.PlayerDefault( ) ),
-    _index( -1 )
-{ }
+    _sessionSeed( seed ),
+    _sessions( 0 ),
+    _seed( SeedDerive( seed, 0 ) ),
+    _index( -1 ),
+    _workers( std::max( 1, static_cast<int>( std::thread::hardware_concurrency( ) ) - 1 ) )
+{
+    SeedRNG( seed );
+}
 
 bool Game::Exist( ) const
 {
     return _dungeons.size( ) != 0;
 }
+const RenderStatistics& Game::GetRenderStatistics( ) const
+{
+    return _renderer.GetStatistics( );
+}
 void Game::Menu( )
 {
     std::string output;
@@ -34,7 +54,6 @@ void Game::Menu( )
 
     while( true )
     {
-        ClearScreen( _clearOutput );
         output.clear( );
         output
             .append( std::string( "[1] Continue current game" ) + ( Exist( ) ? "\n" : "\t[Disabled, no current game]\n" ) )
@@ -43,8 +62,8 @@ void Game::Menu( )
             .append( std::string( "[4] Build new game (Config)" ) + ( _customConfig ? "\n" : "\t[Disabled by server]\n" ) )
             .append( std::string( "[5] Exit" ) + ( _exitable ? "\n" : "\t\t\t[Disabled by server]\n" ) )
             .append( "Select option: \n" );
-        std::cout << output;
-        input = SelectChar( { Exist() ? '1' : '\0', _saveToFile ? '2' : '\0', '3', _customConfig ? '4' : '\0', _exitable ? '5' : '\0' } );
+        _renderer.Present( output );
+        input = SelectChar( _input, { Exist() ? '1' : '\0', _saveToFile ? '2' : '\0', '3', _customConfig ? '4' : '\0', _exitable ? '5' : '\0' } );
 
         switch( input )
         {
@@ -65,9 +84,8 @@ void Game::Menu( )
                 }
                 catch( const std::exception& error )
                 {
-                    std::cout << "\n\nERROR " << error.what( );
-                    std::cout << "\n\nPress enter to continue: \n";
-                    SelectEnter( );
+                    _renderer.Print( std::string( "\n\nERROR " ) + error.what( ) + "\n\nPress enter to continue: \n" );
+                    SelectEnter( _input );
 
                     break;
                 }
@@ -89,7 +107,7 @@ void Game::Menu( )
             }
             case '4':
             {
-                _config = SelectDungeonConfiguration( );
+                _config = SelectDungeonConfiguration( _input, _renderer );
                 Reset( );
                 Start( );
 
@@ -118,30 +136,44 @@ bool Game::Turn( )
         { 'G', Orientation::South },
         { 'H', Orientation::West  }
     };
+    const std::vector<char> valid { 'W', 'A', 'S', 'D', 'E', _saveToFile ? 'R' : '\0', 'F', 'G', 'H' };
     std::string output;
     char input;
+    bool drawn = false;
 
     while( true )
     {
-        ClearScreen( _clearOutput );
-        output.clear( );
-        output
-            .append( GetStringDungeon( _dungeons[_index], _player.real->position, { 32, 16 } ) )
-            .append( "Health: " )
-            .append( GetStringHealth( _player.real->health ) )
-            .append( "\n\n" )
-            .append( "[W] Go North\n" )
-            .append( "[A] Go West\n" )
-            .append( "[S] Go South\n" )
-            .append( "[D] Go East\n" )
-            .append( "[E] Exit to meny\n" )
-            .append( std::string( _saveToFile ? "[R] Exit to meny and save\n" : "" ) )
-            .append( "[F] Rotate dungeon 90'\n" )
-            .append( "[G] Rotate dungeon 180'\n" )
-            .append( "[H] Rotate dungeon 270'\n" )
-            .append( "Select action: \n" );
-        std::cout << output;
-        input = SelectChar( { 'W', 'A', 'S', 'D', 'E', _saveToFile ? 'R' : '\0', 'F', 'G', 'H' }, std::toupper );
+        /* Keys typed ahead are played out before the next frame is drawn */
+        if( !drawn &&
+            !_input.Pending( ) )
+        {
+            output.clear( );
+            output
+                .append( _viewport.Compose( *_dungeons[_index].dungeon, _player.real->position ) )
+                .append( "Health: " )
+                .append( GetStringHealth( _player.real->health ) )
+                .append( "\n\n" )
+                .append( "[W] Go North\n" )
+                .append( "[A] Go West\n" )
+                .append( "[S] Go South\n" )
+                .append( "[D] Go East\n" )
+                .append( "[E] Exit to meny\n" )
+                .append( std::string( _saveToFile ? "[R] Exit to meny and save\n" : "" ) )
+                .append( "[F] Rotate dungeon 90'\n" )
+                .append( "[G] Rotate dungeon 180'\n" )
+                .append( "[H] Rotate dungeon 270'\n" )
+                .append( "Select action: \n" );
+            _renderer.Present( output );
+            drawn = true;
+        }
+
+        /* An invalid key goes back round, drawing a frame skipped for it before waiting again */
+        input = static_cast<char>( std::toupper( _input.Key( ) ) );
+
+        if( std::find( valid.begin( ), valid.end( ), input ) == valid.end( ) )
+        {
+            continue;
+        }
 
         switch( input )
         {
@@ -150,7 +182,7 @@ bool Game::Turn( )
             case 'S':
             case 'D':
             {
-                _dungeons[_index].MovementPlayer( directions.at( input ) );
+                _dungeons[_index].dungeon->MovementPlayer( directions.at( input ) );
 
                 return true;
             }
@@ -171,7 +203,9 @@ bool Game::Turn( )
             case 'G':
             case 'H':
             {
-                _dungeons[_index].Rotate( rotations.at( input ) );
+                _dungeons[_index].dungeon->Rotate( rotations.at( input ) );
+                _renderer.Invalidate( );
+                drawn = false;
 
                 break;
             }
@@ -180,27 +214,33 @@ bool Game::Turn( )
 }
 void Game::Reset( )
 {
+    DungeonsDiscard( );
     _player.Reset( _entityFactory.PlayerDefault( ) );
-    _dungeons.clear( );
-    _dungeons.emplace_back( _player, _entityFactory, _config );
-    _dungeons[0].PlayerSet( std::nullopt );
+    _seed = SeedNext( );
+    _dungeons.emplace_back( SeedDerive( _seed, 0 ) );
+    DungeonMaterialize( 0 ).PlayerSet( std::nullopt );
     _index = 0;
     DungeonConnect( 0 );
 }
+std::uint64_t Game::SeedNext( )
+{
+    /* Every world of a session descends from its seed, so a recorded session rebuilds the same worlds */
+    return SeedDerive( _sessionSeed, ++_sessions );
+}
 void Game::Start( )
 {
     while( _player.real->active &&
            Turn( ) )
     {
-        _dungeons[_index].MovementRandom( );
-        _dungeons[_index].Events( _battleSystem );
+        _dungeons[_index].dungeon->Advance( );
+        _dungeons[_index].dungeon->Events( _battleSystem );
         _player.real->Update( );
 
         if( _player.real->next )
         {
             DungeonAlign( *_player.real->next );
             DungeonConnect( _player.real->next->indexDungeon );
-            _dungeons[_player.real->next->indexDungeon].PlayerSet( _player.real->next->indexDoor );
+            _dungeons[_player.real->next->indexDungeon].dungeon->PlayerSet( _player.real->next->indexDoor );
             _index = _player.real->next->indexDungeon;
             _player.real->next.reset( );
         }
@@ -208,17 +248,18 @@ void Game::Start( )
 }
 void Game::DungeonAlign( const Connector& connector )
 {
-    const auto doorNext = _dungeons[connector.indexDungeon].GetDoors( )[connector.indexDoor];
-    const auto doorPrev = _dungeons[doorNext->connector->indexDungeon].GetDoors( )[doorNext->connector->indexDoor];
-    const int sideNext = RectQuadrantArithmetic( RectQuadrant( doorNext->position, _dungeons[doorPrev->connector->indexDungeon].GetSize( ) ) );
-    const int sidePrev = RectQuadrantArithmetic( RectQuadrant( doorPrev->position, _dungeons[doorNext->connector->indexDungeon].GetSize( ) ) );
+    const auto doorNext = DungeonMaterialize( connector.indexDungeon ).GetDoors( )[connector.indexDoor];
+    const auto doorPrev = DungeonMaterialize( doorNext->connector->indexDungeon ).GetDoors( )[doorNext->connector->indexDoor];
+    const int sideNext = RectQuadrantArithmetic( RectQuadrant( doorNext->position, _dungeons[doorPrev->connector->indexDungeon].dungeon->GetSize( ) ) );
+    const int sidePrev = RectQuadrantArithmetic( RectQuadrant( doorPrev->position, _dungeons[doorNext->connector->indexDungeon].dungeon->GetSize( ) ) );
     const int align = ( ( ( sidePrev - sideNext ) + 3 ) % 4 ) - 1;
 
-    _dungeons[connector.indexDungeon].Rotate( RectQuadrantArithmetic( align ) );
+    _dungeons[connector.indexDungeon].dungeon->Rotate( RectQuadrantArithmetic( align ) );
 }
 void Game::DungeonConnect( int index )
 {
-    const auto doors = _dungeons[index].GetDoors( );
+    /* Neighbours are only stubs until the player walks through their door */
+    const auto doors = DungeonMaterialize( index ).GetDoors( );
     const int size = doors.size( );
 
     for( int i = 0; i < size; i++ )
@@ -227,15 +268,77 @@ void Game::DungeonConnect( int index )
         {
             const int other = _dungeons.size( );
 
-            _dungeons.emplace_back( _player, _entityFactory, _config );
-            _dungeons[index].Connect( { other, 0 }, i );
-            _dungeons[other].Connect( { index, i }, 0 );
+            _dungeons.emplace_back( SeedDerive( _seed, other ), Connector { index, i } );
+            _dungeons[index].dungeon->Connect( { other, 0 }, i );
+        }
+    }
+
+    DungeonPrefetch( index );
+}
+Dungeon& Game::DungeonMaterialize( int index )
+{
+    DungeonSlot& slot = _dungeons[index];
+
+    if( !slot.dungeon )
+    {
+        if( slot.pending.valid( ) )
+        {
+            /* Blocks only if the worker has not finished generating yet */
+            slot.dungeon.emplace( slot.pending.get( ) );
+        }
+        else
+        {
+            slot.dungeon.emplace( _player, _entityFactory, _config, slot.seed );
+        }
+
+        if( slot.entrance )
+        {
+            slot.dungeon->Connect( *slot.entrance, 0 );
+        }
+    }
+
+    return *slot.dungeon;
+}
+void Game::DungeonPrefetch( int index )
+{
+    /* Generate unvisited neighbours in the background while the player explores */
+    DungeonConfiguration config = _config;
+
+    /* The workers already build dungeons side by side, splitting each one as well would oversubscribe */
+    config.options.threads = 1;
+
+    for( const auto& door : _dungeons[index].dungeon->GetDoors( ) )
+    {
+        DungeonSlot& slot = _dungeons[door->connector->indexDungeon];
+
+        if( !slot.dungeon &&
+            !slot.pending.valid( ) )
+        {
+            slot.pending = _workers.Submit( [this, seed = slot.seed, config] ( )
+            {
+                return Dungeon( _player, _entityFactory, config, seed );
+            } );
+        }
+    }
+}
+void Game::DungeonsDiscard( )
+{
+    /* Prefetches read the player and the factory, queued ones are dropped and running ones waited for */
+    _workers.Cancel( );
+
+    for( DungeonSlot& slot : _dungeons )
+    {
+        if( slot.pending.valid( ) )
+        {
+            slot.pending.wait( );
         }
     }
+
+    _dungeons.clear( );
 }
 void Game::Save( )
 {
-    const std::string name = "Dungeoncrawler_Save.txt";
+    const std::string& name = _saveName;
     std::ofstream oFile( name, std::ios::out | std::ios::trunc );
 
     if( !oFile.is_open( ) )
@@ -257,14 +360,28 @@ void Game::Save( )
     oFile << _config.amount.wallsParents << ',';
     oFile << _config.amount.wallsChildren << ',';
     oFile << _config.amount.wallsFillerCycles << ',';
-    oFile << _config.amount.enemies << '\n';
+    oFile << _config.amount.enemies << ',';
+    oFile << _config.options.wallsFillerInPlace << ',';
+    oFile << _config.generate.connectivity << ',';
+    oFile << _config.options.layout << '\n';
     oFile << _index << '\n';
     oFile << _dungeons.size( ) << '\n';
 
     for( int i = 0, limit = _dungeons.size( ); i < limit; i++ )
     {
-        const auto doors = _dungeons[i].GetDoors( );
-        const Vector2<int> size = _dungeons[i].GetSize( );
+        if( !_dungeons[i].dungeon )
+        {
+            /* Unvisited dungeons are stored as a zero size followed by their seed and entrance */
+            oFile << 0 << ',' << 0 << '\n';
+            oFile << _dungeons[i].seed << ',';
+            oFile << _dungeons[i].entrance->indexDungeon << ',';
+            oFile << _dungeons[i].entrance->indexDoor << '\n';
+
+            continue;
+        }
+
+        const auto doors = _dungeons[i].dungeon->GetDoors( );
+        const Vector2<int> size = _dungeons[i].dungeon->GetSize( );
         Vector2<int> iterator;
 
         oFile << size.x << ',';
@@ -274,7 +391,7 @@ void Game::Save( )
         {
             for( iterator.x = 0; iterator.x < size.x; iterator.x++ )
             {
-                oFile << _dungeons[i].GetIcon( iterator );
+                oFile << _dungeons[i].dungeon->GetIcon( iterator );
             }
 
             oFile << '\n';
@@ -293,7 +410,7 @@ void Game::Save( )
 }
 void Game::Load( )
 {
-    const std::string name = "Dungeoncrawler_Save.txt";
+    const std::string& name = _saveName;
     std::ifstream iFile( name, std::ios::in );
     int limit;
     auto GetString = [] ( std::ifstream& stream ) -> std::string
@@ -349,7 +466,8 @@ void Game::Load( )
         throw std::exception( std::string( "Missing file: " + name ).c_str( ) );
     }
 
-    _dungeons.clear( );
+    DungeonsDiscard( );
+    _seed = SeedNext( );
     _config = GetConfig( GetString( iFile ) );
     _index = std::stoi( GetString( iFile ) );
     limit = std::stoi( GetString( iFile ) );
@@ -361,6 +479,23 @@ void Game::Load( )
         Vector2<int> iterator;
         int size;
 
+        if( icons.Size( ) == Vector2<int> { 0, 0 } )
+        {
+            std::stringstream sstream( GetString( iFile ) );
+            std::string value;
+            DungeonSlot slot;
+
+            std::getline( sstream, value, ',' );
+            slot.seed = std::stoull( value );
+            std::getline( sstream, value, ',' );
+            slot.entrance = Connector { std::stoi( value ), 0 };
+            std::getline( sstream, value, ',' );
+            slot.entrance->indexDoor = std::stoi( value );
+            _dungeons.push_back( std::move( slot ) );
+
+            continue;
+        }
+
         for( iterator.y = 0; iterator.y < icons.Size( ).y; iterator.y++ )
         {
             const std::string line = GetString( iFile );
@@ -377,11 +512,14 @@ void Game::Load( )
         {
             const std::vector<int> values = GetVector( GetString( iFile ) );
 
-            doors.push_back( *dynamic_cast<Door*>( _entityFactory.Get( "Door" ).get( ) ) );
+            doors.push_back( *EntityCast<Door>( _entityFactory.Get( "Door" ).get( ) ) );
             doors[i].position  = { values[0], values[1] };
             doors[i].connector = { values[2], values[3] };
         }
 
-        _dungeons.emplace_back( _player, _entityFactory, icons, doors );
+        _dungeons.emplace_back( SeedDerive( _seed, indexDungeon ) );
+        _dungeons.back( ).dungeon.emplace( _player, _entityFactory, icons, doors, SeedDerive( _seed, indexDungeon ) );
     }
+
+    DungeonPrefetch( _index );
 }
\ No newline at end of file
@@ -4,32 +4,60 @@
 #include "BattleSystem.h"
 #include "EntityFactory.h"
 #include "Dungeon.h"
+#include "ThreadPool.h"
+#include "Renderer.h"
+#include "Viewport.h"
+#include "InputSource.h"
+#include <optional>
+#include <future>
+
+struct DungeonSlot
+{
+    DungeonSlot( std::uint64_t seed = 0, const std::optional<Connector>& entrance = std::nullopt );
+
+    std::uint64_t seed;
+    std::optional<Connector> entrance;
+    std::optional<Dungeon> dungeon;
+    std::future<Dungeon> pending;
+};
 
 class Game
 {
     public:
-        Game( bool clear, bool save, bool exit, bool config );
+        Game( InputSource& input, const std::string& saveName, std::uint64_t seed, bool clear, bool save, bool exit, bool config, bool headless );
 
         bool Exist( ) const;
+        const RenderStatistics& GetRenderStatistics( ) const;
         void Menu( );
 
     private:
-        const bool _clearOutput;
         const bool _saveToFile;
         const bool _exitable;
         const bool _customConfig;
+        const std::string _saveName;
+        InputSource& _input;
+        Renderer _renderer;
+        Viewport _viewport;
         const BattleSystem _battleSystem;
         const EntityFactory _entityFactory;
-        std::vector<Dungeon> _dungeons;
+        std::vector<DungeonSlot> _dungeons;
         DungeonConfiguration _config;
         PlayerHandle _player;
+        const std::uint64_t _sessionSeed;
+        int _sessions;
+        std::uint64_t _seed;
         int _index;
+        ThreadPool _workers;
 
         bool Turn( );
         void Reset( );
+        std::uint64_t SeedNext( );
         void Start( );
         void DungeonAlign( const Connector& connector );
         void DungeonConnect( int index );
+        Dungeon& DungeonMaterialize( int index );
+        void DungeonPrefetch( int index );
+        void DungeonsDiscard( );
         void Save( );
         void Load( );
 };
\ No newline at end of file
@@ -14,6 +14,10 @@ class Grid
             _size( size ),
             _data( size.x * size.y )
         { }
+        Grid( const Vector2<int>& size, const T& value ) :
+            _size( size ),
+            _data( size.x * size.y, value )
+        { }
 
         const T& operator[]( const Vector2<int>& position ) const
         {
@@ -0,0 +1,87 @@
+#include "InputSource.h"
+#include <limits>
+
+bool TerminalInput::Pending( )
+{
+    return _keyboard.Pending( );
+}
+char TerminalInput::Key( )
+{
+    return _keyboard.Key( );
+}
+std::string TerminalInput::Token( )
+{
+    return _keyboard.Token( );
+}
+void TerminalInput::Enter( )
+{
+    _keyboard.Enter( );
+}
+
+ScriptedInput::ScriptedInput( const std::string& name ) :
+    _stream( name, std::ios::in )
+{
+    if( !_stream.is_open( ) )
+    {
+        throw std::exception( std::string( "Missing file: " + name ).c_str( ) );
+    }
+}
+bool ScriptedInput::Pending( )
+{
+    /* Trailing whitespace is no command, the position is put back so Enter still finds its line end */
+    const std::streampos position = _stream.tellg( );
+
+    if( position == std::streampos( -1 ) )
+    {
+        return false;
+    }
+
+    const bool pending = !( _stream >> std::ws ).eof( );
+
+    _stream.clear( );
+    _stream.seekg( position );
+
+    return pending;
+}
+char ScriptedInput::Key( )
+{
+    return Token( ).back( );
+}
+std::string ScriptedInput::Token( )
+{
+    std::string token;
+
+    if( !( _stream >> token ) )
+    {
+        throw InputExhausted( );
+    }
+
+    return token;
+}
+void ScriptedInput::Enter( )
+{
+    /* Same as line input from a terminal, so a piped session replays unchanged */
+    _stream.ignore( std::numeric_limits<std::streamsize>::max( ), '\n' );
+    _stream.get( );
+}
+
+GeneratedInput::GeneratedInput( std::function<std::string( )> generator ) :
+    _generator( std::move( generator ) )
+{ }
+bool GeneratedInput::Pending( )
+{
+    /* Words are made on request, so none is ever waiting and every command draws its frame */
+    return false;
+}
+char GeneratedInput::Key( )
+{
+    const std::string token = Token( );
+
+    return token.empty( ) ? '\0' : token.back( );
+}
+std::string GeneratedInput::Token( )
+{
+    return _generator( );
+}
+void GeneratedInput::Enter( )
+{ }
\ No newline at end of file
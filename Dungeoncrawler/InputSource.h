@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Keyboard.h"
+#include <string>
+#include <fstream>
+#include <functional>
+
+class InputSource
+{
+    /*
+        Where the game and battles take their commands from. Key is a single command
+        character, Token a whitespace separated word and Enter a pause for acknowledgement.
+        Pending tells whether another command is ready without waiting, frames in between
+        are skipped. Sources that run dry throw InputExhausted.
+    */
+
+    public:
+        virtual ~InputSource( ) = default;
+
+        virtual bool Pending( ) = 0;
+        virtual char Key( ) = 0;
+        virtual std::string Token( ) = 0;
+        virtual void Enter( ) = 0;
+};
+
+class TerminalInput : public InputSource
+{
+    public:
+        bool Pending( ) override;
+        char Key( ) override;
+        std::string Token( ) override;
+        void Enter( ) override;
+
+    private:
+        Keyboard _keyboard;
+};
+
+class ScriptedInput : public InputSource
+{
+    /* Reads a file laid out as piped terminal input, one command per word */
+
+    public:
+        ScriptedInput( const std::string& name );
+
+        bool Pending( ) override;
+        char Key( ) override;
+        std::string Token( ) override;
+        void Enter( ) override;
+
+    private:
+        std::ifstream _stream;
+};
+
+class GeneratedInput : public InputSource
+{
+    /* Asks a function for every word, such as a random walk for load testing, typed one at a time */
+
+    public:
+        GeneratedInput( std::function<std::string( )> generator );
+
+        bool Pending( ) override;
+        char Key( ) override;
+        std::string Token( ) override;
+        void Enter( ) override;
+
+    private:
+        std::function<std::string( )> _generator;
+};
\ No newline at end of file
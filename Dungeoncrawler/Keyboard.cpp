@@ -0,0 +1,269 @@
+#include "Keyboard.h"
+#include <iostream>
+#include <limits>
+#include <cctype>
+
+#ifdef _WIN32
+#include <conio.h>
+#include <io.h>
+#include <cstdio>
+#else
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <csignal>
+#include <cstdlib>
+#include <cerrno>
+#endif
+
+namespace
+{
+    constexpr char KeyEscape = '\x1b';
+    constexpr char KeyBackspace = '\x7f';
+
+    #ifndef _WIN32
+    /* Kept outside the object so the signal handlers can reach it */
+    termios terminalSaved;
+    volatile std::sig_atomic_t terminalRaw = 0;
+    bool terminalRegistered = false;
+
+    void TerminalRestore( )
+    {
+        if( terminalRaw )
+        {
+            tcsetattr( STDIN_FILENO, TCSANOW, &terminalSaved );
+            terminalRaw = 0;
+        }
+    }
+    void TerminalSignal( int signal )
+    {
+        TerminalRestore( );
+        std::signal( signal, SIG_DFL );
+        std::raise( signal );
+    }
+    #endif
+}
+
+Keyboard::Keyboard( ) :
+    _raw( false ),
+    _escape( 0 )
+{
+    #ifdef _WIN32
+    /* The console hands out single keys through _getch without changing its mode */
+    _raw = _isatty( _fileno( stdin ) ) != 0;
+    #else
+    if( !isatty( STDIN_FILENO ) ||
+        tcgetattr( STDIN_FILENO, &terminalSaved ) != 0 )
+    {
+        return;
+    }
+
+    termios raw = terminalSaved;
+
+    /* Signals and output processing stay enabled, Ctrl+C and newlines behave as before */
+    raw.c_lflag &= ~( ICANON | ECHO );
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+
+    if( tcsetattr( STDIN_FILENO, TCSANOW, &raw ) != 0 )
+    {
+        return;
+    }
+
+    _raw = true;
+    terminalRaw = 1;
+
+    if( !terminalRegistered )
+    {
+        std::atexit( TerminalRestore );
+        terminalRegistered = true;
+    }
+
+    for( const int signal : { SIGINT, SIGTERM, SIGHUP, SIGQUIT, SIGABRT, SIGSEGV, SIGFPE, SIGILL, SIGBUS } )
+    {
+        std::signal( signal, TerminalSignal );
+    }
+    #endif
+}
+Keyboard::~Keyboard( )
+{
+    #ifndef _WIN32
+    TerminalRestore( );
+    #endif
+}
+
+bool Keyboard::Raw( ) const
+{
+    return _raw;
+}
+bool Keyboard::Pending( )
+{
+    if( !_raw )
+    {
+        return false;
+    }
+
+    Poll( false );
+
+    return !_queue.empty( );
+}
+char Keyboard::Key( )
+{
+    if( _raw )
+    {
+        return Next( );
+    }
+
+    /* Line input keeps the old meaning, the last character of the next word */
+    const std::string token = Token( );
+
+    return token.empty( ) ? '\0' : token.back( );
+}
+std::string Keyboard::Token( )
+{
+    std::string token;
+
+    if( !_raw )
+    {
+        if( !( std::cin >> token ) )
+        {
+            throw InputExhausted( );
+        }
+
+        return token;
+    }
+
+    /* Raw mode has no terminal echo or line editing, both are done here */
+    while( true )
+    {
+        const char key = Next( );
+
+        if( std::isspace( static_cast<unsigned char>( key ) ) )
+        {
+            if( !token.empty( ) )
+            {
+                std::cout << '\n' << std::flush;
+
+                return token;
+            }
+        }
+        else if( key == KeyBackspace || key == '\b' )
+        {
+            if( !token.empty( ) )
+            {
+                token.pop_back( );
+                std::cout << "\b \b" << std::flush;
+            }
+        }
+        else if( std::isprint( static_cast<unsigned char>( key ) ) )
+        {
+            token += key;
+            std::cout << key << std::flush;
+        }
+    }
+}
+void Keyboard::Enter( )
+{
+    if( !_raw )
+    {
+        std::cin.ignore( std::numeric_limits<std::streamsize>::max( ), '\n' );
+        std::cin.get( );
+
+        return;
+    }
+
+    while( Next( ) != '\n' );
+}
+
+char Keyboard::Next( )
+{
+    while( _queue.empty( ) )
+    {
+        Poll( true );
+    }
+
+    const char key = _queue.front( );
+
+    _queue.pop_front( );
+
+    return key;
+}
+void Keyboard::Poll( bool block )
+{
+    #ifdef _WIN32
+    while( block || _kbhit( ) )
+    {
+        const int key = _getch( );
+
+        block = false;
+
+        /* Function and arrow keys arrive as a prefix and a scan code, neither is a command */
+        if( key == 0 || key == 0xE0 )
+        {
+            _getch( );
+        }
+        else
+        {
+            Push( key == '\r' ? '\n' : static_cast<char>( key ) );
+        }
+    }
+    #else
+    if( block )
+    {
+        pollfd descriptor { STDIN_FILENO, POLLIN, 0 };
+
+        while( poll( &descriptor, 1, -1 ) < 0 && errno == EINTR );
+    }
+
+    char buffer[64];
+    ssize_t count;
+    bool empty = true;
+
+    while( ( count = read( STDIN_FILENO, buffer, sizeof( buffer ) ) ) > 0 )
+    {
+        empty = false;
+
+        for( ssize_t i = 0; i < count; i++ )
+        {
+            Push( buffer[i] );
+        }
+    }
+
+    /* Woken with nothing to read means end of file or a hangup, waiting again would spin */
+    if( block && empty )
+    {
+        throw InputExhausted( );
+    }
+    #endif
+}
+void Keyboard::Push( char key )
+{
+    /* Escape sequences from arrow and function keys are dropped, their letters would read as commands */
+    if( _escape == 1 )
+    {
+        _escape = key == '[' || key == 'O' ? 2 : 0;
+
+        if( _escape )
+        {
+            return;
+        }
+    }
+    else if( _escape == 2 )
+    {
+        if( key >= '@' && key <= '~' )
+        {
+            _escape = 0;
+        }
+
+        return;
+    }
+
+    if( key == KeyEscape )
+    {
+        _escape = 1;
+
+        return;
+    }
+
+    _queue.push_back( key );
+}
\ No newline at end of file
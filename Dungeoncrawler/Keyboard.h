@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <exception>
+
+struct InputExhausted : public std::exception
+{
+    const char* what( ) const noexcept override
+    {
+        return "Input exhausted";
+    }
+};
+
+class Keyboard
+{
+    /*
+        Reads single keypresses from a terminal switched to raw mode, queueing everything
+        typed ahead so several keys can be handled before the next frame. The terminal is
+        restored on destruction, at exit and from fatal signals. When stdin is not a
+        terminal the original whitespace separated line input is used instead. Input that
+        reaches end of file or hangs up throws InputExhausted.
+    */
+
+    public:
+        Keyboard( );
+        ~Keyboard( );
+        Keyboard( const Keyboard& ) = delete;
+        Keyboard& operator=( const Keyboard& ) = delete;
+
+        bool Raw( ) const;
+        bool Pending( );
+        char Key( );
+        std::string Token( );
+        void Enter( );
+
+    private:
+        bool _raw;
+        int _escape;
+        std::deque<char> _queue;
+
+        char Next( );
+        void Poll( bool block );
+        void Push( char key );
+};
\ No newline at end of file
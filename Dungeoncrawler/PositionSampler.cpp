@@ -0,0 +1,51 @@
+#include "PositionSampler.h"
+
+PositionSampler::PositionSampler( const Vector2<int>& size ) :
+    _indices( size )
+{ }
+
+bool PositionSampler::Insert( const Vector2<int>& position )
+{
+    /* Indices are stored offset by one, zero marks a position outside the set */
+    if( Contains( position ) )
+    {
+        return false;
+    }
+
+    _positions.push_back( position );
+    _indices[position] = _positions.size( );
+
+    return true;
+}
+bool PositionSampler::Erase( const Vector2<int>& position )
+{
+    if( !Contains( position ) )
+    {
+        return false;
+    }
+
+    const int index = _indices[position] - 1;
+
+    _positions[index] = _positions.back( );
+    _indices[_positions[index]] = index + 1;
+    _positions.pop_back( );
+    _indices[position] = 0;
+
+    return true;
+}
+bool PositionSampler::Contains( const Vector2<int>& position ) const
+{
+    return _indices[position] != 0;
+}
+bool PositionSampler::Empty( ) const
+{
+    return _positions.empty( );
+}
+int PositionSampler::Size( ) const
+{
+    return _positions.size( );
+}
+const Vector2<int>& PositionSampler::Sample( RandomGenerator& generator ) const
+{
+    return _positions[generator.Get( 0, _positions.size( ) - 1 )];
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Grid.h"
+#include "Random.h"
+#include <vector>
+
+class PositionSampler
+{
+    /*
+        Set of grid positions with constant time insert, erase and uniform sampling.
+        Positions are kept densely packed, erasing swaps the last position into the gap.
+    */
+
+    public:
+        PositionSampler( const Vector2<int>& size );
+
+        bool Insert( const Vector2<int>& position );
+        bool Erase( const Vector2<int>& position );
+        bool Contains( const Vector2<int>& position ) const;
+        bool Empty( ) const;
+        int Size( ) const;
+        const Vector2<int>& Sample( RandomGenerator& generator ) const;
+
+    private:
+        std::vector<Vector2<int>> _positions;
+        Grid<int> _indices;
+};
\ No newline at end of file
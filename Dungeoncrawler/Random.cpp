@@ -0,0 +1,87 @@
+#include "Random.h"
+#include <random>
+
+namespace
+{
+    std::uint64_t SplitMix64( std::uint64_t value )
+    {
+        /*
+            http://xoshiro.di.unimi.it/splitmix64.c
+            Function implementation is based on the source
+        */
+
+        value += 0x9e3779b97f4a7c15;
+        value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9;
+        value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111eb;
+
+        return value ^ ( value >> 31 );
+    }
+    std::uint32_t Squares32( std::uint64_t counter, std::uint64_t key )
+    {
+        /*
+            https://arxiv.org/abs/2004.06278
+            Squares: A Fast Counter-Based RNG, implementation is based on the paper
+        */
+
+        std::uint64_t x = counter * key;
+        const std::uint64_t y = x;
+        const std::uint64_t z = y + key;
+
+        x = x * x + y;
+        x = ( x >> 32 ) | ( x << 32 );
+        x = x * x + z;
+        x = ( x >> 32 ) | ( x << 32 );
+        x = x * x + y;
+        x = ( x >> 32 ) | ( x << 32 );
+
+        return static_cast<std::uint32_t>( ( x * x + z ) >> 32 );
+    }
+}
+
+RandomGenerator::RandomGenerator( std::uint64_t seed ) :
+    _seed( seed ),
+    _key( SplitMix64( seed ) | 1 ),
+    _counter( 0 )
+{ }
+
+std::uint32_t RandomGenerator::Next( )
+{
+    return Squares32( _counter++, _key );
+}
+int RandomGenerator::Get( int min, int max )
+{
+    /* Lemire's multiply-shift reduction, rejection only on the rare biased values */
+    const std::uint32_t range = static_cast<std::uint32_t>( max - min ) + 1;
+    std::uint64_t multiplied = static_cast<std::uint64_t>( Next( ) ) * range;
+
+    if( static_cast<std::uint32_t>( multiplied ) < range )
+    {
+        const std::uint32_t threshold = ( 0u - range ) % range;
+
+        while( static_cast<std::uint32_t>( multiplied ) < threshold )
+        {
+            multiplied = static_cast<std::uint64_t>( Next( ) ) * range;
+        }
+    }
+
+    return min + static_cast<int>( multiplied >> 32 );
+}
+RandomGenerator RandomGenerator::Split( std::uint64_t stream ) const
+{
+    return RandomGenerator( SeedDerive( _seed, stream ) );
+}
+std::uint64_t RandomGenerator::Seed( ) const
+{
+    return _seed;
+}
+
+std::uint64_t SeedDerive( std::uint64_t seed, std::uint64_t index )
+{
+    return SplitMix64( seed ^ SplitMix64( index ) );
+}
+std::uint64_t SeedRandom( )
+{
+    std::random_device rd;
+
+    return ( static_cast<std::uint64_t>( rd( ) ) << 32 ) | rd( );
+}
\ No newline at end of file
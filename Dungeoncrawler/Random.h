@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+class RandomGenerator
+{
+    /*
+        Counter-based generator, every value is a pure function of ( key, counter ).
+        Streams are split by deriving a new key, so any thread can own its own
+        stream without sharing state and a seed always replays the same sequence.
+    */
+
+    public:
+        RandomGenerator( std::uint64_t seed );
+
+        std::uint32_t Next( );
+        int Get( int min, int max );
+        RandomGenerator Split( std::uint64_t stream ) const;
+        std::uint64_t Seed( ) const;
+
+    private:
+        std::uint64_t _seed;
+        std::uint64_t _key;
+        std::uint64_t _counter;
+};
+
+std::uint64_t SeedDerive( std::uint64_t seed, std::uint64_t index );
+std::uint64_t SeedRandom( );
\ No newline at end of file
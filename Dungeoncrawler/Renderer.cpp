@@ -0,0 +1,262 @@
+#include "Renderer.h"
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <cerrno>
+#endif
+
+namespace
+{
+    constexpr std::string_view SequenceClear = "\x1b[H\x1b[2J";
+    constexpr std::string_view SequenceEraseLine = "\x1b[K";
+    constexpr std::string_view SequenceEraseBelow = "\x1b[J";
+
+    /* Unchanged cells shorter than a cursor jump are resent rather than skipped */
+    constexpr int RunGap = 6;
+}
+
+Renderer::Renderer( bool clear, bool headless ) :
+    _clear( clear ),
+    _headless( headless ),
+    _invalid( true ),
+    _terminal( 0, 0 )
+{
+    #ifdef _WIN32
+    /* Escape sequences are only interpreted once the console is in virtual terminal mode */
+    const HANDLE console = GetStdHandle( STD_OUTPUT_HANDLE );
+    DWORD mode = 0;
+
+    if( _clear && !_headless &&
+        GetConsoleMode( console, &mode ) )
+    {
+        SetConsoleMode( console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING );
+    }
+    #endif
+}
+
+void Renderer::Present( std::string_view frame )
+{
+    _buffer.clear( );
+
+    if( !_clear )
+    {
+        _buffer.append( frame );
+    }
+    else
+    {
+        const std::pair<int, int> terminal = TerminalSize( );
+        std::size_t line = 0;
+
+        for( std::size_t begin = 0; begin <= frame.size( ); line++ )
+        {
+            const std::size_t end = std::min( frame.find( '\n', begin ), frame.size( ) );
+
+            if( line == _current.size( ) )
+            {
+                _current.emplace_back( );
+            }
+
+            _current[line].assign( frame.substr( begin, end - begin ) );
+            begin = end + 1;
+        }
+
+        _current.resize( line );
+
+        /*
+            A resized terminal may have reflowed the old frame and a frame taller than the
+            terminal scrolls, positions are only trusted otherwise. Unknown sizes are trusted.
+            A delta larger than the frame itself gains nothing.
+        */
+        const bool trusted = !_invalid &&
+                             terminal == _terminal &&
+                             ( terminal.second == 0 || static_cast<int>( _current.size( ) ) < terminal.second );
+
+        if( trusted )
+        {
+            ComposeDelta( );
+        }
+
+        if( !trusted ||
+            _buffer.size( ) >= SequenceClear.size( ) + frame.size( ) )
+        {
+            ComposeFull( frame );
+        }
+
+        _previous.swap( _current );
+        _terminal = terminal;
+        _invalid = false;
+    }
+
+    _statistics.frames++;
+    _statistics.bytesLast = _buffer.size( );
+    _statistics.bytesSent += _buffer.size( );
+    _statistics.bytesFull += ( _clear ? SequenceClear.size( ) : 0 ) + frame.size( );
+
+    if( _headless )
+    {
+        return;
+    }
+
+    /* Anything still queued in std::cout belongs before this frame */
+    std::cout.flush( );
+    Write( _buffer );
+}
+void Renderer::Print( std::string_view text )
+{
+    if( _headless )
+    {
+        return;
+    }
+
+    /* Text written outside a frame changes the screen behind the delta's back */
+    _invalid = true;
+    std::cout.flush( );
+    Write( text );
+}
+void Renderer::Invalidate( )
+{
+    _invalid = true;
+}
+const RenderStatistics& Renderer::GetStatistics( ) const
+{
+    return _statistics;
+}
+
+void Renderer::ComposeFull( std::string_view frame )
+{
+    _buffer.clear( );
+    _buffer.append( SequenceClear );
+    _buffer.append( frame );
+}
+void Renderer::ComposeDelta( )
+{
+    for( int y = 0, limit = _current.size( ); y < limit; y++ )
+    {
+        const std::string& current = _current[y];
+        static const std::string empty;
+        const std::string& previous = y < static_cast<int>( _previous.size( ) ) ? _previous[y] : empty;
+        auto Same = [&current, &previous] ( int x )
+        {
+            return x < static_cast<int>( previous.size( ) ) && previous[x] == current[x];
+        };
+
+        if( current == previous &&
+            y < static_cast<int>( _previous.size( ) ) )
+        {
+            continue;
+        }
+
+        /*
+            Tabs make columns depend on the terminal, so such lines are rewritten whole. Rows
+            past the previous frame hold whatever was on screen, they are rewritten and erased.
+        */
+        if( y >= static_cast<int>( _previous.size( ) ) ||
+            current.find( '\t' ) != std::string::npos ||
+            previous.find( '\t' ) != std::string::npos )
+        {
+            CursorMove( y, 0 );
+            _buffer.append( current );
+            _buffer.append( SequenceEraseLine );
+
+            continue;
+        }
+
+        for( int x = 0, size = current.size( ); x < size; )
+        {
+            if( Same( x ) )
+            {
+                x++;
+
+                continue;
+            }
+
+            int end = x + 1;
+
+            for( int next = end; next < size && next - end < RunGap; next++ )
+            {
+                if( !Same( next ) )
+                {
+                    end = next + 1;
+                }
+            }
+
+            CursorMove( y, x );
+            _buffer.append( current, x, end - x );
+            x = end;
+        }
+
+        if( previous.size( ) > current.size( ) )
+        {
+            CursorMove( y, current.size( ) );
+            _buffer.append( SequenceEraseLine );
+        }
+    }
+
+    if( _previous.size( ) > _current.size( ) )
+    {
+        CursorMove( _current.size( ), 0 );
+        _buffer.append( SequenceEraseBelow );
+    }
+
+    /* Leave the cursor where writing the whole frame would have left it, and drop echoed input below */
+    CursorMove( _current.size( ) - 1, _current.back( ).size( ) );
+    _buffer.append( SequenceEraseBelow );
+}
+void Renderer::CursorMove( int row, int column )
+{
+    _buffer.append( "\x1b[" );
+    _buffer.append( std::to_string( row + 1 ) );
+    _buffer.append( ";" );
+    _buffer.append( std::to_string( column + 1 ) );
+    _buffer.append( "H" );
+}
+std::pair<int, int> Renderer::TerminalSize( ) const
+{
+    #ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+
+    if( GetConsoleScreenBufferInfo( GetStdHandle( STD_OUTPUT_HANDLE ), &info ) )
+    {
+        return { info.srWindow.Right - info.srWindow.Left + 1, info.srWindow.Bottom - info.srWindow.Top + 1 };
+    }
+    #else
+    winsize size;
+
+    if( ioctl( STDOUT_FILENO, TIOCGWINSZ, &size ) == 0 )
+    {
+        return { size.ws_col, size.ws_row };
+    }
+    #endif
+
+    return { 0, 0 };
+}
+void Renderer::Write( std::string_view data ) const
+{
+    while( !data.empty( ) )
+    {
+        #ifdef _WIN32
+        const int written = _write( 1, data.data( ), static_cast<unsigned int>( data.size( ) ) );
+        #else
+        const ssize_t written = write( STDOUT_FILENO, data.data( ), data.size( ) );
+
+        if( written < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        #endif
+
+        if( written <= 0 )
+        {
+            return;
+        }
+
+        data.remove_prefix( written );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+struct RenderStatistics
+{
+    std::size_t frames = 0;
+    std::size_t bytesLast = 0;
+    std::size_t bytesSent = 0;
+    std::size_t bytesFull = 0;
+};
+
+class Renderer
+{
+    /*
+        Frames are composed in a reused buffer and handed to the terminal in a single write,
+        instead of spawning a shell to clear. The previous frame is remembered so that only
+        the changed runs of each line are sent, placed with cursor positioning escapes.
+        A headless renderer composes and counts its frames without writing them and drops
+        loose text, so the byte statistics can be measured without a terminal.
+    */
+
+    public:
+        Renderer( bool clear, bool headless );
+
+        void Present( std::string_view frame );
+        void Print( std::string_view text );
+        void Invalidate( );
+        const RenderStatistics& GetStatistics( ) const;
+
+    private:
+        const bool _clear;
+        const bool _headless;
+        bool _invalid;
+        std::pair<int, int> _terminal;
+        std::string _buffer;
+        std::vector<std::string> _previous;
+        std::vector<std::string> _current;
+        RenderStatistics _statistics;
+
+        void ComposeFull( std::string_view frame );
+        void ComposeDelta( );
+        void CursorMove( int row, int column );
+        std::pair<int, int> TerminalSize( ) const;
+        void Write( std::string_view data ) const;
+};
\ No newline at end of file
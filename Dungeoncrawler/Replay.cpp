@@ -0,0 +1,185 @@
+#include "Replay.h"
+#include <sstream>
+#include <thread>
+#include <cstdio>
+
+namespace
+{
+    constexpr char KindKey = 'K';
+    constexpr char KindToken = 'T';
+    constexpr char KindEnter = 'E';
+}
+
+RecordingInput::RecordingInput( InputSource& source, const std::string& name, const SessionHeader& header, const std::string& save ) :
+    _source( source ),
+    _stream( name, std::ios::out | std::ios::trunc | std::ios::binary ),
+    _begin( std::chrono::steady_clock::now( ) )
+{
+    if( !_stream.is_open( ) )
+    {
+        throw std::exception( std::string( "Unable to open file: " + name ).c_str( ) );
+    }
+
+    _stream << header.seed << '\n';
+    _stream << header.save << ',' << header.exit << ',' << header.config << '\n';
+
+    /* The save file is kept byte for byte behind its length, a missing file as -1 */
+    std::ifstream file( save, std::ios::in | std::ios::binary );
+
+    if( file.is_open( ) )
+    {
+        std::stringstream contents;
+
+        contents << file.rdbuf( );
+        _stream << contents.str( ).size( ) << '\n' << contents.str( ) << '\n';
+    }
+    else
+    {
+        _stream << -1 << '\n';
+    }
+
+    _stream.flush( );
+}
+bool RecordingInput::Pending( )
+{
+    return _source.Pending( );
+}
+char RecordingInput::Key( )
+{
+    const char key = _source.Key( );
+
+    /* Keys are logged by code, raw input may hand over whitespace and control characters */
+    Log( KindKey, std::to_string( static_cast<unsigned char>( key ) ) );
+
+    return key;
+}
+std::string RecordingInput::Token( )
+{
+    const std::string token = _source.Token( );
+
+    Log( KindToken, token );
+
+    return token;
+}
+void RecordingInput::Enter( )
+{
+    _source.Enter( );
+    Log( KindEnter, "" );
+}
+
+void RecordingInput::Log( char kind, const std::string& value )
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now( ) - _begin );
+
+    _stream << elapsed.count( ) << ',' << kind << ',' << value << '\n';
+    _stream.flush( );
+}
+
+ReplayInput::ReplayInput( const std::string& name, bool timed ) :
+    _timed( timed ),
+    _header( { } ),
+    _index( 0 )
+{
+    std::ifstream stream( name, std::ios::in | std::ios::binary );
+    std::string line;
+
+    if( !stream.is_open( ) )
+    {
+        throw std::exception( std::string( "Missing file: " + name ).c_str( ) );
+    }
+
+    std::getline( stream, line );
+    _header.seed = std::stoull( line );
+    std::getline( stream, line );
+    _header.save   = line[0] == '1';
+    _header.exit   = line[2] == '1';
+    _header.config = line[4] == '1';
+    std::getline( stream, line );
+
+    if( const long long size = std::stoll( line ); size >= 0 )
+    {
+        _save.emplace( size, '\0' );
+        stream.read( _save->data( ), size );
+        stream.ignore( 1 );
+    }
+
+    while( std::getline( stream, line ) )
+    {
+        std::stringstream sstream( line );
+        std::string time;
+        std::string kind;
+        std::string value;
+
+        std::getline( sstream, time, ',' );
+        std::getline( sstream, kind, ',' );
+        std::getline( sstream, value );
+        _events.push_back( { std::chrono::microseconds( std::stoll( time ) ), kind[0], value } );
+    }
+
+    _begin = std::chrono::steady_clock::now( );
+}
+const SessionHeader& ReplayInput::GetHeader( ) const
+{
+    return _header;
+}
+void ReplayInput::RestoreSave( const std::string& save ) const
+{
+    if( !_save )
+    {
+        std::remove( save.c_str( ) );
+
+        return;
+    }
+
+    std::ofstream file( save, std::ios::out | std::ios::trunc | std::ios::binary );
+
+    if( !file.is_open( ) )
+    {
+        throw std::exception( std::string( "Unable to open file: " + save ).c_str( ) );
+    }
+
+    file << *_save;
+}
+bool ReplayInput::Pending( )
+{
+    if( _index == _events.size( ) )
+    {
+        return false;
+    }
+
+    return !_timed || _begin + _events[_index].time <= std::chrono::steady_clock::now( );
+}
+char ReplayInput::Key( )
+{
+    return static_cast<char>( std::stoi( Next( KindKey ) ) );
+}
+std::string ReplayInput::Token( )
+{
+    return Next( KindToken );
+}
+void ReplayInput::Enter( )
+{
+    Next( KindEnter );
+}
+
+const std::string& ReplayInput::Next( char kind )
+{
+    if( _index == _events.size( ) )
+    {
+        throw InputExhausted( );
+    }
+
+    const Event& event = _events[_index++];
+
+    if( event.kind != kind )
+    {
+        throw std::exception( std::string( "Replay diverged at command " + std::to_string( _index ) ).c_str( ) );
+    }
+
+    if( _timed )
+    {
+        std::this_thread::sleep_until( _begin + event.time );
+    }
+
+    return event.value;
+}
\ No newline at end of file
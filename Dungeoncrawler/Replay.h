@@ -0,0 +1,80 @@
+#pragma once
+
+#include "InputSource.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+struct SessionHeader
+{
+    std::uint64_t seed;
+    bool save;
+    bool exit;
+    bool config;
+};
+
+class RecordingInput : public InputSource
+{
+    /*
+        Passes another source through while logging the session seed, the game options, the
+        save file as it was when the session began and every command with the microseconds
+        since then. Lines are flushed as they are written so a crashed session still leaves
+        its log behind.
+    */
+
+    public:
+        RecordingInput( InputSource& source, const std::string& name, const SessionHeader& header, const std::string& save );
+
+        bool Pending( ) override;
+        char Key( ) override;
+        std::string Token( ) override;
+        void Enter( ) override;
+
+    private:
+        InputSource& _source;
+        std::ofstream _stream;
+        const std::chrono::steady_clock::time_point _begin;
+
+        void Log( char kind, const std::string& value );
+};
+
+class ReplayInput : public InputSource
+{
+    /*
+        Plays a recorded log back. Timed playback waits for each command's original moment
+        and draws the frames in between, otherwise commands follow each other at once. A
+        command of another kind than the game asks for means the replay has diverged.
+        The recorded save file is restored to a file of the replay's own, so loading sees
+        what the session saw and saving leaves the player's save alone.
+    */
+
+    public:
+        ReplayInput( const std::string& name, bool timed );
+
+        const SessionHeader& GetHeader( ) const;
+        void RestoreSave( const std::string& save ) const;
+        bool Pending( ) override;
+        char Key( ) override;
+        std::string Token( ) override;
+        void Enter( ) override;
+
+    private:
+        struct Event
+        {
+            std::chrono::microseconds time;
+            char kind;
+            std::string value;
+        };
+
+        const bool _timed;
+        SessionHeader _header;
+        std::optional<std::string> _save;
+        std::vector<Event> _events;
+        std::size_t _index;
+        std::chrono::steady_clock::time_point _begin;
+
+        const std::string& Next( char kind );
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool( int threads ) :
+    _stopping( false )
+{
+    for( int i = 0; i < threads; i++ )
+    {
+        _threads.emplace_back( &ThreadPool::Work, this );
+    }
+}
+ThreadPool::~ThreadPool( )
+{
+    /* Tasks that have not started are dropped, their futures report a broken promise */
+    {
+        const std::lock_guard<std::mutex> lock( _mutex );
+
+        _stopping = true;
+        _tasks = { };
+    }
+
+    _condition.notify_all( );
+
+    for( auto& thread : _threads )
+    {
+        thread.join( );
+    }
+}
+
+int ThreadPool::Size( ) const
+{
+    return _threads.size( );
+}
+void ThreadPool::Reserve( int threads )
+{
+    const std::lock_guard<std::mutex> lock( _mutex );
+
+    while( static_cast<int>( _threads.size( ) ) < threads )
+    {
+        _threads.emplace_back( &ThreadPool::Work, this );
+    }
+}
+void ThreadPool::Cancel( )
+{
+    /* Same as on destruction, tasks already running are left to finish */
+    const std::lock_guard<std::mutex> lock( _mutex );
+
+    _tasks = { };
+}
+ThreadPool& ThreadPool::Shared( )
+{
+    /* Grows to the largest ParallelFor so far, its threads are started once per process */
+    static ThreadPool pool( 0 );
+
+    return pool;
+}
+void ThreadPool::Work( )
+{
+    while( true )
+    {
+        std::function<void( )> task;
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _condition.wait( lock, [this] ( ) { return _stopping || !_tasks.empty( ); } );
+
+            if( _stopping )
+            {
+                return;
+            }
+
+            task = std::move( _tasks.front( ) );
+            _tasks.pop( );
+        }
+
+        task( );
+    }
+}
\ No newline at end of file
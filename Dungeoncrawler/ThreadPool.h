@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+class ThreadPool
+{
+    public:
+        ThreadPool( int threads );
+        ~ThreadPool( );
+
+        template<class F> auto Submit( F&& function ) -> std::future<decltype( function( ) )>
+        {
+            using Result = decltype( function( ) );
+
+            const auto task = std::make_shared<std::packaged_task<Result( )>>( std::forward<F>( function ) );
+            std::future<Result> future = task->get_future( );
+
+            {
+                const std::lock_guard<std::mutex> lock( _mutex );
+
+                _tasks.emplace( [task] ( ) { ( *task )( ); } );
+            }
+
+            _condition.notify_one( );
+
+            return future;
+        }
+        int Size( ) const;
+        void Reserve( int threads );
+        void Cancel( );
+
+        static ThreadPool& Shared( );
+
+    private:
+        std::vector<std::thread> _threads;
+        std::queue<std::function<void( )>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stopping;
+
+        void Work( );
+};
+
+template<class F> void ParallelFor( int count, int threads, F&& body )
+{
+    /*
+        Runs body( 0 ) to body( count - 1 ), the caller works alongside threads - 1 helpers
+        from the shared pool and a single item or thread runs inline. Helpers starting after
+        every item was taken return at once, so the caller only waits for items in progress.
+    */
+    const int helpers = std::min( threads, count ) - 1;
+
+    if( helpers <= 0 )
+    {
+        for( int i = 0; i < count; i++ )
+        {
+            body( i );
+        }
+
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<int> next { 0 };
+        int finished = 0;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    const auto state = std::make_shared<State>( );
+    const auto function = &body;
+    auto Work = [state, function, count] ( )
+    {
+        int finished = 0;
+
+        for( int i = state->next++; i < count; i = state->next++ )
+        {
+            ( *function )( i );
+            finished++;
+        }
+
+        if( finished )
+        {
+            const std::lock_guard<std::mutex> lock( state->mutex );
+
+            state->finished += finished;
+            state->condition.notify_all( );
+        }
+    };
+    ThreadPool& pool = ThreadPool::Shared( );
+
+    pool.Reserve( helpers );
+
+    for( int i = 0; i < helpers; i++ )
+    {
+        pool.Submit( Work );
+    }
+
+    Work( );
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+
+    state->condition.wait( lock, [&state, count] ( ) { return state->finished == count; } );
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "Viewport.h"
+#include "Dungeon.h"
+#include <algorithm>
+
+Viewport::Viewport( const Vector2<int>& sizeScreen ) :
+    _sizeScreen( sizeScreen ),
+    _sizeFrame( sizeScreen + 3 ),
+    _frame( static_cast<std::size_t>( _sizeFrame.x + 1 ) * _sizeFrame.y, ' ' )
+{
+    const std::size_t stride = _sizeFrame.x + 1;
+
+    for( int y = 0; y < _sizeFrame.y; y++ )
+    {
+        char* row = &_frame[y * stride];
+
+        if( y == 0 || y == _sizeFrame.y - 1 )
+        {
+            std::fill( row, row + _sizeFrame.x, '/' );
+        }
+        else
+        {
+            row[0] = '/';
+            row[_sizeFrame.x - 1] = '/';
+        }
+
+        row[_sizeFrame.x] = '\n';
+    }
+}
+
+std::string_view Viewport::Compose( const Dungeon& dungeon, const Vector2<int>& center )
+{
+    const Vector2<int> origoCamera = center - _sizeScreen / 2;
+    const Vector2<int>& sizeDungeon = dungeon.GetSize( );
+    const std::size_t stride = _sizeFrame.x + 1;
+    const int width = _sizeFrame.x - 2;
+
+    /* Columns of the interior that fall inside the dungeon, the rest stay blank */
+    const int columnBegin = std::clamp( -origoCamera.x, 0, width );
+    const int columnEnd   = std::clamp( sizeDungeon.x - origoCamera.x, columnBegin, width );
+
+    for( int row = 1; row < _sizeFrame.y - 1; row++ )
+    {
+        const int y = origoCamera.y + row - 1;
+        char* output = &_frame[row * stride + 1];
+
+        if( y < 0 || y >= sizeDungeon.y || columnBegin == columnEnd )
+        {
+            std::fill( output, output + width, ' ' );
+            continue;
+        }
+
+        const char* icons  = dungeon.GetIconRow( y ) + origoCamera.x + columnBegin;
+        const char* vision = dungeon.GetVisionRow( y ) + origoCamera.x + columnBegin;
+        char* span = output + columnBegin;
+
+        std::fill( output, span, ' ' );
+
+        /* Branchless select on the all-or-nothing vision mask, left for the compiler to vectorize */
+        for( int x = 0, limit = columnEnd - columnBegin; x < limit; x++ )
+        {
+            span[x] = static_cast<char>( ( icons[x] & vision[x] ) | ( ' ' & ~vision[x] ) );
+        }
+
+        std::fill( output + columnEnd, output + width, ' ' );
+    }
+
+    return _frame;
+}
\ No newline at end of file
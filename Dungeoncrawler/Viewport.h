@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Vector2.h"
+#include <string>
+#include <string_view>
+
+class Dungeon;
+
+class Viewport
+{
+    /*
+        Composes the camera view of a dungeon into a frame kept between calls. The border is
+        written once on construction, each turn only the visible span of every row is copied
+        from the icon plane and masked by the vision plane.
+    */
+
+    public:
+        Viewport( const Vector2<int>& sizeScreen );
+
+        std::string_view Compose( const Dungeon& dungeon, const Vector2<int>& center );
+
+    private:
+        const Vector2<int> _sizeScreen;
+        const Vector2<int> _sizeFrame;
+        std::string _frame;
+};
\ No newline at end of file
@@ -1,14 +1,77 @@
 #include "Game.h"
+#include "InputSource.h"
+#include "Replay.h"
+#include <memory>
+#include <iostream>
+#include <string>
 
 int main( int argc, char* argv[] )
 {
+    static const std::string saveName = "Dungeoncrawler_Save.txt";
+    static const std::string replaySaveName = "Dungeoncrawler_Replay_Save.txt";
     const bool noclear  = ( argc > 1 ? !strcmp( argv[1], "noclear"  ) : false );
     const bool nosave   = ( argc > 2 ? !strcmp( argv[2], "nosave"   ) : false );
     const bool noexit   = ( argc > 3 ? !strcmp( argv[3], "noexit"   ) : false );
     const bool noconfig = ( argc > 4 ? !strcmp( argv[4], "noconfig" ) : false );
-    Game game( !noclear, !nosave, !noexit, !noconfig );
+    const bool headless = ( argc > 5 ? !strcmp( argv[5], "headless" ) : false );
+    const bool script   = ( argc > 6 ? !!strcmp( argv[6], "terminal" ) : false );
+    const bool record   = ( argc > 8 ? !strcmp( argv[7], "record"   ) : false );
+    const bool replay   = ( argc > 8 ? !strcmp( argv[7], "replay"   ) || !strcmp( argv[7], "replayfast" ) : false );
+    std::unique_ptr<InputSource> source;
+    std::unique_ptr<InputSource> input;
+    SessionHeader header { SeedRandom( ), !nosave, !noexit, !noconfig };
 
-    game.Menu( );
+    try
+    {
+        if( replay )
+        {
+            /* The recorded options replace the ones given, only the output is chosen here */
+            auto playback = std::make_unique<ReplayInput>( argv[8], !strcmp( argv[7], "replay" ) );
+
+            header = playback->GetHeader( );
+            playback->RestoreSave( replaySaveName );
+            input = std::move( playback );
+        }
+        else
+        {
+            if( script )
+            {
+                source = std::make_unique<ScriptedInput>( argv[6] );
+            }
+            else
+            {
+                source = std::make_unique<TerminalInput>( );
+            }
+
+            if( record )
+            {
+                input = std::make_unique<RecordingInput>( *source, argv[8], header, saveName );
+            }
+        }
+    }
+    catch( const std::exception& error )
+    {
+        std::cout << "ERROR " << error.what( ) << '\n';
+
+        return 1;
+    }
+
+    Game game( input ? *input : *source, replay ? replaySaveName : saveName, header.seed, !noclear, header.save, header.exit, header.config, headless );
+
+    try
+    {
+        game.Menu( );
+    }
+    catch( const InputExhausted& )
+    {
+        /* A script or replay that ends without choosing exit simply stops the session */
+    }
+    catch( const std::exception& error )
+    {
+        std::cout << "\n\nERROR " << error.what( ) << '\n';
+
+        return 1;
+    }
 
     return 0;
 }
\ No newline at end of file